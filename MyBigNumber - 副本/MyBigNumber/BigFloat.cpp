@@ -0,0 +1,1080 @@
+#include "BigFloat.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    // 无符号整数，低位字在前，去掉高位的0字（0 为空）
+    typedef std::vector<Limb> Limbs;
+
+    void Trim(Limbs& a)
+    {
+        a.resize(LimbOps::Normalized(a.data(), a.size()));
+    }
+
+    size_t SignificantBits(const Limbs& a)
+    {
+        return LimbOps::BitLength(a.data(), a.size());
+    }
+
+    bool TestBit(const Limbs& a, size_t index)
+    {
+        size_t limb = index / LIMB_BITS;
+        return limb < a.size() && ((a[limb] >> (index % LIMB_BITS)) & 1) != 0;
+    }
+
+    // 低 count 位中是否有1
+    bool AnyBitBelow(const Limbs& a, size_t count)
+    {
+        size_t full = std::min(count / LIMB_BITS, a.size());
+        for (size_t i = 0; i < full; ++i)
+        {
+            if (a[i] != 0)
+            {
+                return true;
+            }
+        }
+        size_t rest = count % LIMB_BITS;
+        return full < a.size() && rest != 0 && (a[full] & ((Limb(1) << rest) - 1)) != 0;
+    }
+
+    void ShiftLeftBy(Limbs& a, size_t shift)
+    {
+        if (a.empty() || shift == 0)
+        {
+            return;
+        }
+        size_t n = a.size() + shift / LIMB_BITS + 1;
+        a.resize(n, 0);
+        LimbOps::ShiftLeft(a.data(), a.data(), n, shift);
+        Trim(a);
+    }
+
+    void ShiftRightBy(Limbs& a, size_t shift)
+    {
+        LimbOps::ShiftRight(a.data(), a.data(), a.size(), shift);
+        Trim(a);
+    }
+
+    void Increment(Limbs& a)
+    {
+        for (Limb& limb : a)
+        {
+            if (++limb != 0)
+            {
+                return;
+            }
+        }
+        a.push_back(1);
+    }
+
+    int CompareMagnitude(const Limbs& a, const Limbs& b)
+    {
+        if (a.size() != b.size())
+        {
+            return a.size() > b.size() ? 1 : -1;
+        }
+        return LimbOps::Compare(a.data(), b.data(), a.size());
+    }
+
+    void AddTo(Limbs& a, Limbs b)
+    {
+        size_t n = std::max(a.size(), b.size()) + 1;
+        a.resize(n, 0);
+        b.resize(n, 0);
+        LimbOps::Add(a.data(), a.data(), b.data(), n);
+        Trim(a);
+    }
+
+    // a -= b，要求 a >= b
+    void SubtractFrom(Limbs& a, Limbs b)
+    {
+        b.resize(a.size(), 0);
+        LimbOps::Sub(a.data(), a.data(), b.data(), a.size());
+        Trim(a);
+    }
+
+    Limbs Multiply(const Limbs& a, const Limbs& b)
+    {
+        if (a.empty() || b.empty())
+        {
+            return Limbs();
+        }
+        Limbs r(a.size() + b.size());
+        LimbOps::Mul(r.data(), a.data(), a.size(), b.data(), b.size());
+        Trim(r);
+        return r;
+    }
+
+    // 返回 a / b，余数存入 remainder。b 不能为0
+    Limbs DivideRem(const Limbs& a, const Limbs& b, Limbs& remainder)
+    {
+        if (a.size() < b.size())
+        {
+            remainder = a;
+            return Limbs();
+        }
+        Limbs q(a.size() - b.size() + 1), r(b.size());
+        LimbOps::DivRem(q.data(), r.data(), a.data(), a.size(), b.data(), b.size());
+        Trim(q);
+        Trim(r);
+        remainder.swap(r);
+        return q;
+    }
+
+    // 10^k = 5^k * 2^k，2 的幂总是并入二进制指数，只需要 5^k
+    Limbs PowerOfFive(unsigned long long k)
+    {
+        Limbs result(1, 1), base(1, 5);
+        while (k != 0)
+        {
+            if ((k & 1) != 0)
+            {
+                result = Multiply(result, base);
+            }
+            k >>= 1;
+            if (k != 0)
+            {
+                base = Multiply(base, base);
+            }
+        }
+        return result;
+    }
+
+    // 只保留 a 的最高 bits 位（向下截断），返回右移的位数；舍去的位不全为0时把 exact 置为 false
+    size_t TruncateTo(Limbs& a, size_t bits, bool& exact)
+    {
+        size_t length = SignificantBits(a);
+        if (length <= bits)
+        {
+            return 0;
+        }
+        size_t shift = length - bits;
+        exact = exact && !AnyBitBelow(a, shift);
+        ShiftRightBy(a, shift);
+        return shift;
+    }
+
+    // 5^k 的近似下界 L * 2^scale，L 不超过 bits 位：与 PowerOfFive 相同的二进制幂，但每次乘法后截断到 bits 位，
+    // 代价只与 bits 有关。每次截断的相对误差小于 2^(1 - bits)，在结果中累计的次数不超过 4k + 64，
+    // 所以 5^k < (L + PowerOfFiveError(k)) * 2^scale（要求 bits 比该误差多出至少2位）。
+    // 没有舍去任何非0位时 exact 为 true，此时 L * 2^scale 就是 5^k
+    Limbs PowerOfFiveTruncated(unsigned long long k, size_t bits, long long& scale, bool& exact)
+    {
+        Limbs result(1, 1), base(1, 5);
+        long long baseScale = 0;
+        scale = 0;
+        exact = true;
+        while (k != 0)
+        {
+            if ((k & 1) != 0)
+            {
+                result = Multiply(result, base);
+                scale += baseScale + static_cast<long long>(TruncateTo(result, bits, exact));
+            }
+            k >>= 1;
+            if (k != 0)
+            {
+                base = Multiply(base, base);
+                baseScale = 2 * baseScale + static_cast<long long>(TruncateTo(base, bits, exact));
+            }
+        }
+        return result;
+    }
+
+    // PowerOfFiveTruncated 的误差上界，单位是 L 的最低位
+    Limbs PowerOfFiveError(unsigned long long k)
+    {
+        return Limbs(1, 16 * static_cast<Limb>(k) + 257);
+    }
+
+    // floor(sqrt(n))，n 不为0。用 double 估计最高几十位得到不小于结果的初值，
+    // 之后整数 Newton 迭代单调下降，不再下降时就是结果
+    Limbs SquareRoot(const Limbs& n)
+    {
+        size_t length = SignificantBits(n);
+        size_t half = length > 62 ? (length - 62) / 2 : 0;
+        Limbs top(n);
+        ShiftRightBy(top, 2 * half);
+
+        double estimate = std::sqrt(static_cast<double>(top[0]) + 1.0) * (1.0 + 1.0 / (1 << 30)) + 1.0;
+        Limbs x(1, static_cast<Limb>(estimate));
+        ShiftLeftBy(x, half);
+
+        while (true)
+        {
+            Limbs remainder;
+            Limbs y = DivideRem(n, x, remainder);
+            AddTo(y, x);
+            ShiftRightBy(y, 1);
+            if (CompareMagnitude(y, x) >= 0)
+            {
+                return x;
+            }
+            x.swap(y);
+        }
+    }
+
+    // 舍去部分不为0时是否进位。half：舍去部分小于一半为 -1，正好一半为 0，大于一半为 1
+    bool ShouldRoundUp(RoundingMode mode, bool negative, bool odd, int half)
+    {
+        switch (mode)
+        {
+        case RoundingMode::NearestEven:
+            return half > 0 || (half == 0 && odd);
+        case RoundingMode::NearestAway:
+            return half >= 0;
+        case RoundingMode::Upward:
+            return !negative;
+        case RoundingMode::Downward:
+            return negative;
+        default:
+            return false;
+        }
+    }
+
+    // 把 (m + δ) * 2^exponent（0 <= δ < 1，sticky 表示 δ != 0）舍入到不超过 precision 位，
+    // 且最低位不低于 2^minExponent。m 改写为舍入后的整数，返回它的指数。
+    // 不需要舍去任何位时 m 不变（sticky 为 true 时调用方保证 m 有足够的保护位）
+    long long RoundMagnitude(Limbs& m, long long exponent, size_t precision, long long minExponent,
+        bool negative, bool sticky, RoundingMode mode)
+    {
+        long long shift = static_cast<long long>(SignificantBits(m)) - static_cast<long long>(precision);
+        if (exponent + shift < minExponent)
+        {
+            shift = minExponent - exponent;
+        }
+        if (shift <= 0)
+        {
+            return exponent;
+        }
+
+        bool round = TestBit(m, static_cast<size_t>(shift - 1));
+        sticky = sticky || AnyBitBelow(m, static_cast<size_t>(shift - 1));
+        ShiftRightBy(m, static_cast<size_t>(shift));
+        exponent += shift;
+
+        if (round || sticky)
+        {
+            int half = !round ? -1 : (sticky ? 1 : 0);
+            bool odd = !m.empty() && (m[0] & 1) != 0;
+            if (ShouldRoundUp(mode, negative, odd, half))
+            {
+                Increment(m);
+                if (SignificantBits(m) > precision)
+                {
+                    // 进位到 2^precision，右移一位仍是精确的
+                    ShiftRightBy(m, 1);
+                    ++exponent;
+                }
+            }
+        }
+        return exponent;
+    }
+
+    // 值在 [lower, upper] * 2^exponent 内。舍入是单调的，两端舍入到 precision 位的结果相同时就是值的舍入结果，
+    // 这时 lower 改写为它并返回 true，exponent 改为它的指数
+    bool RoundsAlike(Limbs& lower, Limbs upper, long long& exponent, size_t precision, bool negative, RoundingMode mode)
+    {
+        long long lowerExponent = RoundMagnitude(lower, exponent, precision, std::numeric_limits<long long>::min(), negative, false, mode);
+        long long upperExponent = RoundMagnitude(upper, exponent, precision, std::numeric_limits<long long>::min(), negative, false, mode);
+        if (lowerExponent != upperExponent || CompareMagnitude(lower, upper) != 0)
+        {
+            return false;
+        }
+        exponent = lowerExponent;
+        return true;
+    }
+
+    const BigFloat& AsBigFloat(const Number& value)
+    {
+        const BigFloat* result = dynamic_cast<const BigFloat*>(&value);
+        if (result == nullptr)
+        {
+            throw std::invalid_argument("Number types do not match");
+        }
+        return *result;
+    }
+}
+
+BigFloat::BigFloat(size_t Precision) :Number(Precision + 1)
+{
+    if (Precision == 0)
+    {
+        throw std::invalid_argument("Precision must be positive");
+    }
+    this->NumberType = Type::FloatIngpoint;
+    MarkValid();
+}
+
+BigFloat::BigFloat(const BigInt& value, size_t Precision) :BigFloat(Precision)
+{
+    size_t NeedGroup = value.GetLimbCount();
+    Limbs magnitude(value.GetData(), value.GetData() + NeedGroup);
+    bool negative = NeedGroup != 0 && value.GetBit(value.GetBitSize() - 1) == 1;
+    if (negative)
+    {
+        LimbOps::Negate(magnitude.data(), magnitude.data(), NeedGroup);
+        magnitude.back() &= LimbOps::TopMask(value.GetBitSize());
+    }
+    Assign(negative, magnitude, 0, false);
+    if (!value.IsValid())
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+BigFloat::BigFloat(double value, size_t Precision) :BigFloat(Precision)
+{
+    if (!std::isfinite(value))
+    {
+        throw std::invalid_argument("Cannot convert infinity or NaN");
+    }
+
+    // 按 IEEE 754 binary64 的位布局拆开：1位符号、11位指数、52位尾数
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 63) != 0;
+    long long biased = static_cast<long long>((bits >> 52) & 0x7ff);
+
+    Limbs magnitude(1, bits & ((std::uint64_t(1) << 52) - 1));
+    long long exponent = -1074;  // 非规格化数
+    if (biased != 0)
+    {
+        magnitude[0] |= std::uint64_t(1) << 52;
+        exponent = biased - 1075;
+    }
+    Assign(negative, magnitude, exponent, false);
+}
+
+BigFloat::BigFloat(const char* num, size_t Precision) :BigFloat(num, Precision, RoundingMode::NearestEven)
+{
+}
+
+BigFloat::BigFloat(const char* num, size_t Precision, RoundingMode mode) :BigFloat(Precision)
+{
+    Rounding = mode;
+    ParseDecimal(num);
+}
+
+void BigFloat::ParseDecimal(const char* num)
+{
+    const char* p = num;
+    bool negative = false;
+    if (*p == '-' || *p == '+')
+    {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // 值为 digits * 10^exponent10
+    std::string digits;
+    long long exponent10 = 0;
+    for (; std::isdigit(static_cast<unsigned char>(*p)); ++p)
+    {
+        digits.push_back(*p);
+    }
+    if (*p == '.')
+    {
+        for (++p; std::isdigit(static_cast<unsigned char>(*p)); ++p)
+        {
+            digits.push_back(*p);
+            --exponent10;
+        }
+    }
+    if (digits.empty())
+    {
+        throw std::invalid_argument("Invalid floating point string");
+    }
+
+    if (*p == 'e' || *p == 'E')
+    {
+        ++p;
+        bool exponentNegative = false;
+        if (*p == '-' || *p == '+')
+        {
+            exponentNegative = *p == '-';
+            ++p;
+        }
+        if (!std::isdigit(static_cast<unsigned char>(*p)))
+        {
+            throw std::invalid_argument("Invalid floating point string");
+        }
+
+        long long value = 0;
+        for (; std::isdigit(static_cast<unsigned char>(*p)); ++p)
+        {
+            value = value * 10 + (*p - '0');
+            if (value > 1000000000000000LL)
+            {
+                throw std::out_of_range("Exponent out of range");
+            }
+        }
+        exponent10 += exponentNegative ? -value : value;
+    }
+    if (*p != '\0')
+    {
+        throw std::invalid_argument("Invalid floating point string");
+    }
+
+    // 每位十进制数字不超过 log2(10) < 3.322 位
+    size_t NeedGroup = (digits.size() * 3322 / 1000 + LIMB_BITS) / LIMB_BITS + 1;
+    Limbs magnitude(NeedGroup);
+    LimbOps::FromString(magnitude.data(), NeedGroup, digits.data(), digits.size(), 10);
+    Trim(magnitude);
+    if (magnitude.empty())
+    {
+        SetZero(negative);
+        return;
+    }
+
+    // 值为 magnitude * 5^k * 2^exponent10（k = |exponent10|，exponent10 < 0 时除以 5^k）。
+    // 精确的 5^k 有 2.33k 位，所以只把它算到工作精度 work 位（见 PowerOfFiveTruncated），得到包含真值的小区间，
+    // 两端舍入结果相同就是正确的舍入结果，否则加倍 work 重试。5^k 不超过 work 位时近似值就是精确的，直接舍入，
+    // 因此重试总会结束；耗时只与 Precision 有关，与指数大小无关
+    unsigned long long k = static_cast<unsigned long long>(exponent10 >= 0 ? exponent10 : -exponent10);
+    Limbs error = PowerOfFiveError(k);
+    size_t work = GetPrecision() + 64 + SignificantBits(error);
+    while (true)
+    {
+        long long scale;
+        bool exact;
+        Limbs power = PowerOfFiveTruncated(k, work, scale, exact);
+
+        if (exponent10 >= 0)
+        {
+            // 5^k 在 [power, power + error) * 2^scale 内
+            Limbs product = Multiply(magnitude, power);
+            long long exponent = exponent10 + scale;
+            if (exact)
+            {
+                Assign(negative, product, exponent, false);
+                return;
+            }
+            Limbs upper = Multiply(magnitude, error);
+            AddTo(upper, product);
+            if (RoundsAlike(product, upper, exponent, GetPrecision(), negative, Rounding))
+            {
+                Assign(negative, product, exponent, false);
+                return;
+            }
+        }
+        else
+        {
+            // 除以 5^k 时商至少保留 work + 2 位，精确时余数并入粘滞位
+            long long shift = static_cast<long long>(work + 2 + SignificantBits(power)) - static_cast<long long>(SignificantBits(magnitude));
+            shift = std::max<long long>(shift, 0);
+            Limbs dividend(magnitude);
+            ShiftLeftBy(dividend, static_cast<size_t>(shift));
+            long long exponent = exponent10 - scale - shift;
+
+            Limbs remainder;
+            Limbs quotient = DivideRem(dividend, power, remainder);
+            if (exact)
+            {
+                Assign(negative, quotient, exponent, !remainder.empty());
+                return;
+            }
+            // 商在 [dividend / (power + error), dividend / power] 内
+            Limbs larger(power);
+            AddTo(larger, error);
+            Limbs lower = DivideRem(dividend, larger, remainder);
+            Increment(quotient);
+            if (RoundsAlike(lower, quotient, exponent, GetPrecision(), negative, Rounding))
+            {
+                Assign(negative, lower, exponent, false);
+                return;
+            }
+        }
+        work *= 2;
+    }
+}
+
+size_t BigFloat::GetPrecision() const
+{
+    return BitSize - 1;
+}
+
+long long BigFloat::GetExponent() const
+{
+    return Exponent;
+}
+
+bool BigFloat::IsZero() const
+{
+    // 非0时 M 的最高位一定为1
+    return GetBit(GetPrecision() - 1) == 0;
+}
+
+bool BigFloat::IsNegative() const
+{
+    return GetBit(BitSize - 1) == 1;
+}
+
+void BigFloat::SetPrecision(size_t Precision)
+{
+    if (Precision == 0)
+    {
+        throw std::invalid_argument("Precision must be positive");
+    }
+
+    bool negative = IsNegative();
+    bool valid = IsValid();
+    Limbs magnitude = Significand();
+    ResizeStorage(Precision + 1);
+    Assign(negative, magnitude, Exponent, false);
+    if (valid)
+    {
+        MarkValid();
+    }
+    else
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+void BigFloat::SetRoundingMode(RoundingMode mode)
+{
+    Rounding = mode;
+}
+
+RoundingMode BigFloat::GetRoundingMode() const
+{
+    return Rounding;
+}
+
+Limbs BigFloat::Significand() const
+{
+    size_t precision = GetPrecision();
+    Limbs magnitude(Data, Data + LimbOps::LimbCount(precision));
+    magnitude.back() &= LimbOps::TopMask(precision);
+    Trim(magnitude);
+    return magnitude;
+}
+
+void BigFloat::SetZero(bool negative)
+{
+    std::fill_n(Data, GetLimbCount(), 0);
+    Exponent = 0;
+    if (negative)
+    {
+        InvertSignBit();
+    }
+}
+
+void BigFloat::Assign(bool negative, Limbs& magnitude, long long exponent, bool sticky)
+{
+    Trim(magnitude);
+    if (magnitude.empty())
+    {
+        SetZero(negative);
+        return;
+    }
+
+    size_t precision = GetPrecision();
+    exponent = RoundMagnitude(magnitude, exponent, precision, std::numeric_limits<long long>::min(), negative, sticky, Rounding);
+
+    // 左对齐，使 M 的最高位落在第 Precision - 1 位
+    size_t length = SignificantBits(magnitude);
+    ShiftLeftBy(magnitude, precision - length);
+    exponent -= static_cast<long long>(precision - length);
+
+    std::fill_n(Data, GetLimbCount(), 0);
+    std::copy(magnitude.begin(), magnitude.end(), Data);
+    Exponent = exponent;
+    if (negative)
+    {
+        InvertSignBit();
+    }
+}
+
+void BigFloat::MergeInvalid(const BigFloat& other)
+{
+    // 浮点数的各位不能分开传播：任一操作数有无效位时结果全部无效。
+    // 下面写入结果时不改变无效位（符号位用 InvertSignBit 设置）
+    if (!IsValid() || !other.IsValid())
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+void BigFloat::Widen(const BigFloat& other)
+{
+    // 二元运算的结果取两者中较大的精度
+    if (other.GetPrecision() > GetPrecision())
+    {
+        SetPrecision(other.GetPrecision());
+    }
+}
+
+BigInt BigFloat::ToBigInt(size_t BitSize) const
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    Limbs result(NeedGroup, 0);
+    if (!IsZero())
+    {
+        Limbs magnitude = Significand();
+        if (Exponent >= 0)
+        {
+            if (static_cast<unsigned long long>(Exponent) < BitSize)
+            {
+                std::copy_n(magnitude.begin(), std::min(magnitude.size(), NeedGroup), result.begin());
+                LimbOps::ShiftLeft(result.data(), result.data(), NeedGroup, static_cast<size_t>(Exponent));
+            }
+        }
+        else
+        {
+            // 向0取整：直接丢掉小数部分
+            ShiftRightBy(magnitude, static_cast<size_t>(std::min<long long>(-Exponent, std::numeric_limits<long long>::max())));
+            std::copy_n(magnitude.begin(), std::min(magnitude.size(), NeedGroup), result.begin());
+        }
+
+        if (IsNegative())
+        {
+            LimbOps::Negate(result.data(), result.data(), NeedGroup);
+        }
+    }
+    BigInt value(result.data(), BitSize);
+    if (!IsValid())
+    {
+        value.MarkInvalidFrom(0);
+    }
+    return value;
+}
+
+double BigFloat::ToDouble() const
+{
+    double result = 0.0;
+    if (!IsZero())
+    {
+        // 舍入到53位，且最低位不低于 2^-1074（非规格化数的精度）
+        Limbs magnitude = Significand();
+        long long exponent = RoundMagnitude(magnitude, Exponent, 53, -1074, IsNegative(), false, Rounding);
+        if (exponent + static_cast<long long>(SignificantBits(magnitude)) > 1024)
+        {
+            // 不小于 2^1024 时与 IEEE 754 的上溢一致：向0方向的舍入得到最大有限值，其他方式得到 inf
+            bool infinite = ShouldRoundUp(Rounding, IsNegative(), false, 1);
+            result = infinite ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::max();
+        }
+        else if (!magnitude.empty())
+        {
+            // 不超过53位的整数转换为 double 是精确的
+            result = std::ldexp(static_cast<double>(magnitude[0]), static_cast<int>(exponent));
+        }
+    }
+    return IsNegative() ? -result : result;
+}
+
+std::string BigFloat::ToString(size_t digits) const
+{
+    std::string result;
+    if (IsNegative())
+    {
+        result.push_back('-');
+    }
+    if (IsZero())
+    {
+        result.push_back('0');
+        return result;
+    }
+
+    // 默认取 ceil(Precision * log10(2)) + 1 位，足以精确还原
+    if (digits == 0)
+    {
+        digits = GetPrecision() * 30103 / 100000 + 2;
+    }
+
+    // 值在 [2^top, 2^(top+1)) 内，按它估计的十进制指数只可能偏小1
+    Limbs magnitude = Significand();
+    long long top = Exponent + static_cast<long long>(GetPrecision()) - 1;
+    long long exponent10 = static_cast<long long>(std::floor(static_cast<double>(top) * 0.30102999566398120));
+
+    std::string text;
+    while (true)
+    {
+        // N = round(|x| * 10^scale) = round(M * 5^scale * 2^(Exponent + scale))，应恰好有 digits 位
+        long long scale = static_cast<long long>(digits) - 1 - exponent10;
+        long long binary = Exponent + scale;
+        Limbs numerator(magnitude), denominator(1, 1);
+        if (scale >= 0)
+        {
+            numerator = Multiply(numerator, PowerOfFive(scale));
+        }
+        else
+        {
+            denominator = PowerOfFive(-scale);
+        }
+        if (binary >= 0)
+        {
+            ShiftLeftBy(numerator, static_cast<size_t>(binary));
+        }
+        else
+        {
+            ShiftLeftBy(denominator, static_cast<size_t>(-binary));
+        }
+
+        Limbs remainder;
+        Limbs quotient = DivideRem(numerator, denominator, remainder);
+        if (!remainder.empty())
+        {
+            ShiftLeftBy(remainder, 1);
+            int half = CompareMagnitude(remainder, denominator);
+            bool odd = !quotient.empty() && (quotient[0] & 1) != 0;
+            if (ShouldRoundUp(Rounding, IsNegative(), odd, half))
+            {
+                Increment(quotient);
+            }
+        }
+
+        text.clear();
+        LimbOps::ToDecimal(text, quotient.data(), quotient.size());
+        if (text.size() > digits)
+        {
+            // 估计偏小，或者舍入进位到了 10^digits
+            ++exponent10;
+            continue;
+        }
+        break;
+    }
+
+    text.resize(text.find_last_not_of('0') + 1);
+    if (exponent10 >= -5 && exponent10 < static_cast<long long>(digits))
+    {
+        if (exponent10 >= 0)
+        {
+            size_t integerDigits = static_cast<size_t>(exponent10) + 1;
+            if (text.size() <= integerDigits)
+            {
+                result += text;
+                result.append(integerDigits - text.size(), '0');
+            }
+            else
+            {
+                result.append(text, 0, integerDigits);
+                result.push_back('.');
+                result.append(text, integerDigits, std::string::npos);
+            }
+        }
+        else
+        {
+            result += "0.";
+            result.append(static_cast<size_t>(-exponent10 - 1), '0');
+            result += text;
+        }
+    }
+    else
+    {
+        result.push_back(text[0]);
+        if (text.size() > 1)
+        {
+            result.push_back('.');
+            result.append(text, 1, std::string::npos);
+        }
+        result.push_back('e');
+        result.push_back(exponent10 < 0 ? '-' : '+');
+        result += std::to_string(std::llabs(exponent10));
+    }
+    return result;
+}
+
+BigFloat& BigFloat::operator+=(const BigFloat& other)
+{
+    add(other, false);
+    return *this;
+}
+
+BigFloat& BigFloat::operator-=(const BigFloat& other)
+{
+    add(other, true);
+    return *this;
+}
+
+BigFloat& BigFloat::operator*=(const BigFloat& other)
+{
+    multiply(other);
+    return *this;
+}
+
+BigFloat& BigFloat::operator/=(const BigFloat& other)
+{
+    divide(other);
+    return *this;
+}
+
+BigFloat BigFloat::operator+(const BigFloat& other) const
+{
+    BigFloat result(*this);
+    result.Widen(other);
+    result.add(other, false);
+    return result;
+}
+
+BigFloat BigFloat::operator-(const BigFloat& other) const
+{
+    BigFloat result(*this);
+    result.Widen(other);
+    result.add(other, true);
+    return result;
+}
+
+BigFloat BigFloat::operator*(const BigFloat& other) const
+{
+    BigFloat result(*this);
+    result.Widen(other);
+    result.multiply(other);
+    return result;
+}
+
+BigFloat BigFloat::operator/(const BigFloat& other) const
+{
+    BigFloat result(*this);
+    result.Widen(other);
+    result.divide(other);
+    return result;
+}
+
+BigFloat BigFloat::operator-() const
+{
+    BigFloat result(*this);
+    result.ToNegative();
+    return result;
+}
+
+void BigFloat::add(const Number& other, bool subtract)
+{
+    const BigFloat& b = AsBigFloat(other);
+    MergeInvalid(b);
+    bool aNegative = IsNegative();
+    bool bNegative = b.IsNegative() != subtract;
+
+    if (b.IsZero())
+    {
+        if (IsZero())
+        {
+            // 同号的0相加保持符号，异号得 +0（向 -inf 舍入时为 -0）
+            SetZero(aNegative == bNegative ? aNegative : Rounding == RoundingMode::Downward);
+        }
+        return;
+    }
+    if (IsZero())
+    {
+        Limbs magnitude = b.Significand();
+        Assign(bNegative, magnitude, b.Exponent, false);
+        return;
+    }
+
+    Limbs x = Significand(), y = b.Significand();
+    long long ex = Exponent, ey = b.Exponent;
+    bool xNegative = aNegative, yNegative = bNegative;
+    long long tx = ex + static_cast<long long>(SignificantBits(x)) - 1;
+    long long ty = ey + static_cast<long long>(SignificantBits(y)) - 1;
+    if (ty > tx)
+    {
+        std::swap(x, y);
+        std::swap(ex, ey);
+        std::swap(xNegative, yNegative);
+        std::swap(tx, ty);
+    }
+
+    // y 整个落在 x 的最低位之下、且比舍入位低两位以上时，只影响粘滞位（减法时还决定借位），
+    // 换成同样在这个范围内的 2^(limit-2)，避免按很大的指数差移位
+    long long limit = std::min(ex, tx - static_cast<long long>(GetPrecision()) - 2);
+    if (ty + 1 <= limit - 1)
+    {
+        y.assign(1, 1);
+        ey = limit - 2;
+    }
+
+    // 对齐到较小的指数后精确相加减，最后只舍入一次
+    long long exponent = std::min(ex, ey);
+    ShiftLeftBy(x, static_cast<size_t>(ex - exponent));
+    ShiftLeftBy(y, static_cast<size_t>(ey - exponent));
+
+    bool negative = xNegative;
+    if (xNegative == yNegative)
+    {
+        AddTo(x, y);
+    }
+    else
+    {
+        int order = CompareMagnitude(x, y);
+        if (order == 0)
+        {
+            SetZero(Rounding == RoundingMode::Downward);
+            return;
+        }
+        if (order > 0)
+        {
+            SubtractFrom(x, y);
+        }
+        else
+        {
+            SubtractFrom(y, x);
+            x.swap(y);
+            negative = yNegative;
+        }
+    }
+    Assign(negative, x, exponent, false);
+}
+
+void BigFloat::multiply(const Number& other)
+{
+    const BigFloat& b = AsBigFloat(other);
+    MergeInvalid(b);
+    bool negative = IsNegative() != b.IsNegative();
+    if (IsZero() || b.IsZero())
+    {
+        SetZero(negative);
+        return;
+    }
+
+    Limbs product = Multiply(Significand(), b.Significand());
+    Assign(negative, product, Exponent + b.Exponent, false);
+}
+
+void BigFloat::divide(const Number& other)
+{
+    const BigFloat& b = AsBigFloat(other);
+    if (b.IsZero())
+    {
+        throw std::domain_error("Division by zero");
+    }
+    MergeInvalid(b);
+
+    bool negative = IsNegative() != b.IsNegative();
+    if (IsZero())
+    {
+        SetZero(negative);
+        return;
+    }
+
+    // 商至少保留 Precision + 2 位，余数并入粘滞位
+    Limbs x = Significand(), y = b.Significand();
+    long long shift = static_cast<long long>(GetPrecision() + 2 + SignificantBits(y)) - static_cast<long long>(SignificantBits(x));
+    shift = std::max<long long>(shift, 0);
+    ShiftLeftBy(x, static_cast<size_t>(shift));
+
+    Limbs remainder;
+    Limbs quotient = DivideRem(x, y, remainder);
+    Assign(negative, quotient, Exponent - b.Exponent - shift, !remainder.empty());
+}
+
+void BigFloat::modulo(const Number&)
+{
+    throw std::invalid_argument("Modulo is not defined for floating point numbers");
+}
+
+BigFloat BigFloat::Sqrt() const
+{
+    BigFloat result(*this);
+    result.MergeInvalid(*this);
+    if (IsZero())
+    {
+        return result;  // sqrt(-0) = -0
+    }
+    if (IsNegative())
+    {
+        throw std::domain_error("Square root of negative number");
+    }
+
+    // 左移使指数为偶数且被开方数至少 2(Precision + 2) 位，平方根就有 Precision + 2 位
+    Limbs x = Significand();
+    long long shift = 2 * static_cast<long long>(GetPrecision() + 2) - static_cast<long long>(SignificantBits(x));
+    shift = std::max<long long>(shift, 0);
+    if (((Exponent - shift) & 1) != 0)
+    {
+        ++shift;
+    }
+    ShiftLeftBy(x, static_cast<size_t>(shift));
+
+    Limbs root = SquareRoot(x);
+    bool inexact = CompareMagnitude(Multiply(root, root), x) != 0;
+    result.Assign(false, root, (Exponent - shift) / 2, inexact);
+    return result;
+}
+
+int BigFloat::Compare(const BigFloat& other) const
+{
+    bool aZero = IsZero();
+    bool bZero = other.IsZero();
+    if (aZero && bZero)
+    {
+        return 0;
+    }
+
+    bool aNegative = !aZero && IsNegative();
+    bool bNegative = !bZero && other.IsNegative();
+    if (aZero || bZero || aNegative != bNegative)
+    {
+        // 符号不同（0 看作介于正负数之间）
+        int aSign = aZero ? 0 : (aNegative ? -1 : 1);
+        int bSign = bZero ? 0 : (bNegative ? -1 : 1);
+        return aSign < bSign ? -1 : 1;
+    }
+
+    // 同号：先比较最高位的位置，相同时把两个 M 左对齐后逐字比较
+    int order;
+    long long ta = Exponent + static_cast<long long>(GetPrecision());
+    long long tb = other.Exponent + static_cast<long long>(other.GetPrecision());
+    if (ta != tb)
+    {
+        order = ta > tb ? 1 : -1;
+    }
+    else
+    {
+        Limbs x = Significand(), y = other.Significand();
+        if (GetPrecision() < other.GetPrecision())
+        {
+            ShiftLeftBy(x, other.GetPrecision() - GetPrecision());
+        }
+        else
+        {
+            ShiftLeftBy(y, GetPrecision() - other.GetPrecision());
+        }
+        order = CompareMagnitude(x, y);
+    }
+    return aNegative ? -order : order;
+}
+
+#if NUMBER_HAS_THREE_WAY_COMPARE
+std::strong_ordering BigFloat::operator<=>(const BigFloat& other) const
+{
+    return Compare(other) <=> 0;
+}
+#endif
+
+bool BigFloat::operator==(const BigFloat& other) const
+{
+    return Compare(other) == 0;
+}
+
+bool BigFloat::operator!=(const BigFloat& other) const
+{
+    return Compare(other) != 0;
+}
+
+bool BigFloat::operator>=(const BigFloat& other) const
+{
+    return Compare(other) >= 0;
+}
+
+bool BigFloat::operator<=(const BigFloat& other) const
+{
+    return Compare(other) <= 0;
+}
+
+bool BigFloat::operator>(const BigFloat& other) const
+{
+    return Compare(other) > 0;
+}
+
+bool BigFloat::operator<(const BigFloat& other) const
+{
+    return Compare(other) < 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "BigInt.h"
+#include "Number.h"
+#include <string>
+
+// IEEE 754 的舍入方式
+enum class RoundingMode
+{
+	NearestEven,   // 就近舍入，正好一半时取偶数（默认）
+	NearestAway,   // 就近舍入，正好一半时远离0
+	TowardZero,
+	Upward,        // 向 +inf
+	Downward       // 向 -inf
+};
+
+// 任意精度的二进制浮点数，值为 (-1)^s * M * 2^Exponent，M 是 Precision 位的整数，非0时最高位为1。
+// 存储沿用 Number：Data 的低 Precision 位存放 M，第 Precision 位（最高位）是符号位，
+// 因此 Number::ToNegative 对它就是取反符号位。指数是64位整数，实际不会溢出，所以没有无穷大和 NaN，
+// 除以0和负数开平方抛出 std::domain_error；0 带符号（-0）。
+//
+// 每次运算先得到精确结果（或足够的保护位加粘滞位），再按目标精度与舍入方式只舍入一次。
+// 与 BigInt 的位宽一样，a + b 等二元运算的精度取两者中较大的，a += b 等复合赋值保持 a 的精度；
+// 舍入方式取左操作数的设置
+class BigFloat :public Number
+{
+public:
+	explicit BigFloat(size_t Precision);                // 值为0
+	BigFloat(const BigInt& value, size_t Precision);
+	BigFloat(double value, size_t Precision);           // value 不能为无穷大或 NaN
+	// 十进制串，如 "-12.5"、"3e-7"、"1.25E+10"，按舍入方式舍入到 Precision 位。
+	// 耗时与指数大小无关；e 后的指数超过 10^15 时抛出 std::out_of_range
+	BigFloat(const char* num, size_t Precision);
+	BigFloat(const char* num, size_t Precision, RoundingMode mode);
+	BigFloat(const BigFloat& other) = default;
+	BigFloat(BigFloat&& other) noexcept = default;
+
+	BigFloat& operator=(const BigFloat& other) = default;
+	BigFloat& operator=(BigFloat&& other) noexcept = default;
+
+	size_t GetPrecision() const;
+	long long GetExponent() const;   // 0 的指数为0
+	bool IsZero() const;
+	bool IsNegative() const;
+	// 改变精度，按当前舍入方式舍入（增大精度是精确的）
+	void SetPrecision(size_t Precision);
+	void SetRoundingMode(RoundingMode mode);
+	RoundingMode GetRoundingMode() const;
+
+	BigInt ToBigInt(size_t BitSize) const;   // 向0取整，按 BitSize 位回绕
+	// 按舍入方式舍入到 double（含非规格化数）。舍入后绝对值不小于 2^1024 时，舍入方向朝向0
+	// （TowardZero、正数的 Downward、负数的 Upward）得到 ±DBL_MAX，否则得到 ±inf
+	double ToDouble() const;
+	// 十进制表示，digits 为有效数字位数，0 表示足以精确还原的位数。指数在 [-5, digits) 内用定点格式，
+	// 否则用科学计数法（如 "1.5e-7"），末尾的0去掉
+	std::string ToString(size_t digits = 0) const;
+
+	BigFloat& operator+=(const BigFloat& other);
+	BigFloat& operator-=(const BigFloat& other);
+	BigFloat& operator*=(const BigFloat& other);
+	BigFloat& operator/=(const BigFloat& other);
+	BigFloat operator+(const BigFloat& other) const;
+	BigFloat operator-(const BigFloat& other) const;
+	BigFloat operator*(const BigFloat& other) const;
+	BigFloat operator/(const BigFloat& other) const;
+	BigFloat operator-() const;
+	BigFloat Sqrt() const;   // 保持当前精度
+
+	// 按数值比较，-0 与 +0 相等，返回 -1 / 0 / 1
+	int Compare(const BigFloat& other) const;
+#if NUMBER_HAS_THREE_WAY_COMPARE
+	std::strong_ordering operator<=>(const BigFloat& other) const;
+#endif
+	bool operator==(const BigFloat& other) const;
+	bool operator!=(const BigFloat& other) const;
+	bool operator>=(const BigFloat& other) const;
+	bool operator<=(const BigFloat& other) const;
+	bool operator>(const BigFloat& other) const;
+	bool operator<(const BigFloat& other) const;
+
+	virtual ~BigFloat() override = default;
+
+private:
+	long long Exponent = 0;
+	RoundingMode Rounding = RoundingMode::NearestEven;
+
+	std::vector<Limb> Significand() const;   // M，去掉高位的0字
+	// 把 (magnitude + δ) * 2^exponent 舍入后存入本对象（0 <= δ < 1，sticky 表示 δ != 0）。
+	// sticky 为 true 时 magnitude 至少要有 Precision + 2 位
+	void Assign(bool negative, std::vector<Limb>& magnitude, long long exponent, bool sticky);
+	void SetZero(bool negative);
+	void MergeInvalid(const BigFloat& other);
+	void Widen(const BigFloat& other);
+	void ParseDecimal(const char* num);
+
+protected:
+	void add(const Number& other, bool subtract);
+	void multiply(const Number& other);
+	void divide(const Number& other);
+	void modulo(const Number& other);
+};
@@ -1,255 +1,713 @@
-#include "BigInt.h"
-#include <cmath>
-#include <iostream>
-#include <string>
-#include <vector>
-
-BigInt::BigInt(const char* num, size_t BitSize):Number(BitSize)
-{
-    this->NumberType = Type::Integer;
-    StringToBinary(num);
-}
-
-BigInt::BigInt(const char* num, size_t BitSize, int radix) :Number(BitSize)
-{
-
-}
-
-BigInt::BigInt(int num, size_t BitSize) : Number(BitSize)
-{
-    std::string numStr = std::to_string(num);
-    StringToBinary(numStr);
-}
-
-void BigInt::StringToBinary(const std::string& numberStr)
-{
-    bool isNegative = (numberStr[0] == '-');
-    size_t startIndex = isNegative ? 1 : 0;
-    std::string numStr = numberStr.substr(startIndex);
-
-    // Clear existing bits
-    for (size_t i = 0; i < BitSize; ++i)
-    {
-        ClearBit(i);
-    }
-
-    // Convert the decimal number to binary
-    std::vector<bool> binaryRepresentation;
-
-    while (!numStr.empty())
-    {
-        int remainder = 0;
-        std::string newNumStr;
-
-        for (char c : numStr)
-        {
-            int currentDigit = remainder * 10 + (c - '0');
-            remainder = currentDigit % 2;
-            if (!(newNumStr.empty() && currentDigit / 2 == 0))
-            {
-                newNumStr.push_back(currentDigit / 2 + '0');
-            }
-        }
-
-        binaryRepresentation.push_back(remainder);
-        numStr = newNumStr;
-    }
-
-    // Store the binary representation into the Data array
-    for (size_t i = 0; i < binaryRepresentation.size() && i < BitSize; ++i)
-    {
-        if (binaryRepresentation[i])
-        {
-            SetBit(i);
-        }
-    }
-
-    // If the number is negative, convert to two's complement
-    if (isNegative)
-    {
-        ToNegative();
-    }
-}
-
-std::string addStrings(const std::string& num1, const std::string& num2)
-{
-    int carry = 0;
-    int maxLength = std::max(num1.size(), num2.size());
-    std::string result;
-    for (int i = 0; i < maxLength; ++i)
-    {
-        int digit1 = i < num1.size() ? num1[num1.size() - 1 - i] - '0' : 0;
-        int digit2 = i < num2.size() ? num2[num2.size() - 1 - i] - '0' : 0;
-        int sum = digit1 + digit2 + carry;
-        result.push_back(sum % 10 + '0');
-        carry = sum / 10;
-    }
-    if (carry > 0)
-    {
-        result.push_back(carry + '0');
-    }
-    std::reverse(result.begin(), result.end());
-    return result;
-}
-
-std::string BigInt::ToString() const
-{
-    // ǷΪ
-    bool isNegative = (this->GetBit(BitSize - 1) == 1);
-
-    // һʱת޸ԭʼݣ
-    BigInt temp = *this;
-    if (isNegative)
-    {
-        temp.ToNegative(); // תΪת
-    }
-
-    std::string result = "0";
-    std::string base = "1";
-
-    for (size_t i = 0; i < temp.BitSize; ++i)
-    {
-        if (temp.GetBit(i))
-        {
-            result = addStrings(result, base);
-        }
-        base = addStrings(base, base); // base *= 2;
-    }
-
-    if (isNegative)
-    {
-        result = "-" + result;
-    }
-
-    return result;
-}
-
-BigInt& BigInt::operator+=(const Number& other)
-{
-    this->add(other, false);
-    return *this;
-}
-
-BigInt BigInt::operator+(const Number& other) const
-{
-    BigInt result = *this;
-    result.add(other, false);
-    return result;
-}
-
-BigInt& BigInt::operator+=(int value)
-{
-    BigInt temp(value, this->BitSize);
-    this->add(temp, false);
-    return *this;
-}
-
-BigInt BigInt::operator+(int value) const
-{
-    BigInt result = *this;
-    BigInt temp(value, this->BitSize);
-    result.add(temp, false);
-    return result;
-}
-
-void BigInt::add(const Number& other, bool subtract)
-{
-    if (BitSize != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    size_t NeedGroup = (BitSize + 7) / 8;
-    unsigned carry = subtract ? 1 : 0;  // If subtracting, start with carry as 1 to handle two's complement
-    unsigned char* tempData = static_cast<unsigned char*>(malloc(NeedGroup));
-
-    if (tempData == nullptr)
-    {
-        throw std::bad_alloc();
-    }
-
-    for (size_t i = 0; i < NeedGroup; ++i)
-    {
-        unsigned temp1 = Data[i];
-        unsigned temp2 = other.GetData()[i];
-
-        if (subtract)
-        {
-            temp2 = ~temp2;
-        }
-
-        unsigned sum = temp1 + temp2 + carry;
-        carry = (sum > 0xFF) ? 1 : 0;
-        tempData[i] = sum & 0xFF;
-    }
-
-    std::copy(tempData, tempData + NeedGroup, Data);
-    free(tempData);
-
-    if (subtract)
-    {
-        bool carry = true;
-        for (size_t i = 0; i < BitSize && carry; ++i)
-        {
-            if (GetBit(i) == 0)
-            {
-                SetBit(i);
-                carry = false;
-            }
-            else
-            {
-                ClearBit(i);
-            }
-        }
-    }
-}
-
-void BigInt::multiply(const Number& other)
-{
-    if (BitSize != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    Number result(BitSize);
-    Number temp(*this);
-
-    for (size_t i = 0; i < BitSize; ++i)
-    {
-        if (other.GetBit(i))
-        {
-            result += temp;
-        }
-        temp <<= 1;
-    }
-
-    std::copy(result.GetData(), result.GetData() + (BitSize + 7) / 8, Data);
-}
-
-void BigInt::divide(const Number& other)
-{
-    if (BitSize != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    Number dividend(*this);
-    Number divisor(other);
-    Number quotient(BitSize);
-    Number one(BitSize);
-
-    one.SetBit(0);
-
-    for (size_t i = BitSize; i > 0; --i)
-    {
-        quotient <<= 1;
-        if (dividend >= divisor)
-        {
-            dividend -= divisor;
-            quotient |= one;
-        }
-        divisor >>= 1;
-    }
-
-    std::copy(quotient.GetData(), quotient.GetData() + (BitSize + 7) / 8, Data);
-}
\ No newline at end of file
+#include "BigInt.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // A machine integer as a 65-bit two's-complement value (wide enough for both int64_t and uint64_t);
+    // the general paths, such as auto-grow, take it as a ConstNumberView
+    const size_t ScalarBits = LIMB_BITS + 1;
+
+    void ScalarLimbs(Limb* limbs, std::uint64_t magnitude, bool negative)
+    {
+        negative = negative && magnitude != 0;
+        limbs[0] = negative ? 0 - magnitude : magnitude;
+        limbs[1] = negative ? ~Limb(0) : 0;
+    }
+}
+
+BigInt::BigInt(const char* num, size_t BitSize):Number(BitSize)
+{
+    this->NumberType = Type::Integer;
+    StringToBinary(num, std::strlen(num), 10);
+    MarkValid();
+}
+
+BigInt::BigInt(const char* num, size_t BitSize, int radix) :Number(BitSize)
+{
+    this->NumberType = Type::Integer;
+    StringToBinary(num, std::strlen(num), radix);
+    MarkValid();
+}
+
+BigInt::BigInt(const Limb* limbs, size_t BitSize) : Number(BitSize)
+{
+    this->NumberType = Type::Integer;
+    std::copy(limbs, limbs + GetLimbCount(), Data);
+    ClearUnusedBits();
+    MarkValid();
+}
+
+BigInt::BigInt(const ConstNumberView& view) : Number(view.GetBitSize())
+{
+    this->NumberType = Type::Integer;
+    view.Load(Data, GetLimbCount());
+    ClearUnusedBits();
+    MarkValid();
+}
+
+void BigInt::StringToBinary(const char* num, size_t length, int radix)
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Parse, GetLimbCount());
+    bool isNegative = length > 0 && num[0] == '-';
+    size_t startIndex = length > 0 && (num[0] == '-' || num[0] == '+') ? 1 : 0;
+    if (startIndex == 1 && length == 1)
+    {
+        throw std::invalid_argument("No digits to parse");
+    }
+
+    // Digits beyond BitSize are dropped, matching the two's complement wrap of the operators
+    LimbOps::FromString(Data, GetLimbCount(), num + startIndex, length - startIndex, radix);
+    ClearUnusedBits();
+
+    // If the number is negative, convert to two's complement
+    if (isNegative)
+    {
+        ToNegative();
+    }
+}
+
+std::string BigInt::ToString() const
+{
+    return ToString(10);
+}
+
+std::string BigInt::ToString(int radix) const
+{
+    std::string result;
+    result.reserve(MaxStringLength(radix));
+    Write([&result](const char* text, size_t length) { result.append(text, length); }, radix);
+    return result;
+}
+
+BigInt::ToCharsResult BigInt::ToChars(char* first, char* last, int radix) const
+{
+    // Only copy once the output is known to fit, so an undersized buffer is never overrun
+    size_t capacity = static_cast<size_t>(last - first);
+    if (MaxStringLength(radix) <= capacity)
+    {
+        char* out = first;
+        Write([&out](const char* text, size_t length) { out = std::copy(text, text + length, out); }, radix);
+        return { out, std::errc() };
+    }
+
+    char* out = first;
+    bool overflow = false;
+    Write([&](const char* text, size_t length)
+        {
+            if (overflow || length > static_cast<size_t>(last - out))
+            {
+                overflow = true;
+                return;
+            }
+            out = std::copy(text, text + length, out);
+        }, radix);
+    if (overflow)
+    {
+        return { last, std::errc::value_too_large };
+    }
+    return { out, std::errc() };
+}
+
+size_t BigInt::MaxStringLength(int radix) const
+{
+    // One extra character for the sign
+    return LimbOps::DigitCountBound(BitSize, radix) + 1;
+}
+
+void BigInt::Write(const LimbOps::TextSink& sink, int radix, bool uppercase) const
+{
+    if (GetBit(BitSize - 1) != 0)
+    {
+        sink("-", 1);
+    }
+    WriteMagnitude(sink, radix, uppercase);
+}
+
+void BigInt::WriteMagnitude(const LimbOps::TextSink& sink, int radix, bool uppercase) const
+{
+    INSTRUMENT_SCOPE(Instrument::Op::ToString, GetLimbCount());
+    LimbOps::TempLimbs magnitude(GetLimbCount());
+    LimbOps::Magnitude(magnitude.data(), Data, BitSize);
+    LimbOps::WriteDigits(sink, magnitude.data(), GetLimbCount(), radix, uppercase);
+}
+
+std::ostream& operator<<(std::ostream& os, const BigInt& value)
+{
+    std::ios_base::fmtflags flags = os.flags();
+    bool uppercase = (flags & std::ios_base::uppercase) != 0;
+    std::string prefix;
+    if (value < 0)
+    {
+        prefix = "-";
+    }
+    else if (flags & std::ios_base::showpos)
+    {
+        prefix = "+";
+    }
+
+    int radix = 10;
+    if ((flags & std::ios_base::basefield) == std::ios_base::hex)
+    {
+        radix = 16;
+    }
+    else if ((flags & std::ios_base::basefield) == std::ios_base::oct)
+    {
+        radix = 8;
+    }
+    // Like the built-in integers, zero gets no base prefix
+    if ((flags & std::ios_base::showbase) && radix != 10 && value != 0)
+    {
+        prefix += radix == 8 ? "0" : (uppercase ? "0X" : "0x");
+    }
+
+    // Padding needs the total length up front, so only a padded field builds the whole string.
+    // std::internal puts the fill between the sign/base prefix and the digits, like the built-in integers
+    if (os.width() > 0)
+    {
+        std::string digits;
+        value.WriteMagnitude([&digits](const char* text, size_t length) { digits.append(text, length); }, radix, uppercase);
+        size_t length = prefix.size() + digits.size();
+        size_t width = static_cast<size_t>(os.width());
+        if ((os.flags() & std::ios_base::adjustfield) == std::ios_base::internal && width > length)
+        {
+            os.width(0);
+            return os << prefix + std::string(width - length, os.fill()) + digits;
+        }
+        return os << prefix + digits;
+    }
+
+    std::ostream::sentry guard(os);
+    if (guard)
+    {
+        os.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+        value.WriteMagnitude([&os](const char* digits, size_t length) { os.write(digits, static_cast<std::streamsize>(length)); },
+            radix, uppercase);
+    }
+    return os;
+}
+
+BigInt& BigInt::operator+=(const Number& other)
+{
+    this->add(other, false);
+    return *this;
+}
+
+BigInt BigInt::operator+(const Number& other) const&
+{
+    BigInt result = *this;
+    result.Widen(other.GetBitSize());
+    result.add(other, false);
+    return result;
+}
+
+BigInt BigInt::operator+(const Number& other) &&
+{
+    // *this is a temporary, reuse its storage for the result
+    this->Widen(other.GetBitSize());
+    this->add(other, false);
+    return std::move(*this);
+}
+
+BigInt BigInt::operator-(const Number& other) const&
+{
+    BigInt result = *this;
+    result.Widen(other.GetBitSize());
+    result.add(other, true);
+    return result;
+}
+
+BigInt BigInt::operator-(const Number& other) &&
+{
+    this->Widen(other.GetBitSize());
+    this->add(other, true);
+    return std::move(*this);
+}
+
+BigInt BigInt::operator*(const Number& other) const&
+{
+    BigInt result = *this;
+    result.Widen(other.GetBitSize());
+    result.multiply(other);
+    return result;
+}
+
+BigInt BigInt::operator*(const Number& other) &&
+{
+    this->Widen(other.GetBitSize());
+    this->multiply(other);
+    return std::move(*this);
+}
+
+BigInt BigInt::operator/(const Number& other) const&
+{
+    BigInt result = *this;
+    result.Widen(other.GetBitSize());
+    result.divide(other);
+    return result;
+}
+
+BigInt BigInt::operator/(const Number& other) &&
+{
+    this->Widen(other.GetBitSize());
+    this->divide(other);
+    return std::move(*this);
+}
+
+BigInt BigInt::operator%(const Number& other) const&
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.modulo(other);
+    return result;
+}
+
+BigInt BigInt::operator%(const Number& other) &&
+{
+    this->Widen(other.GetBitSize());
+    this->modulo(other);
+    return std::move(*this);
+}
+
+BigInt& BigInt::operator+=(const ConstNumberView& other)
+{
+    this->add(other, false);
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const ConstNumberView& other)
+{
+    this->add(other, true);
+    return *this;
+}
+
+BigInt& BigInt::operator*=(const ConstNumberView& other)
+{
+    this->multiply(other);
+    return *this;
+}
+
+BigInt& BigInt::operator/=(const ConstNumberView& other)
+{
+    this->divide(other);
+    return *this;
+}
+
+BigInt& BigInt::operator%=(const ConstNumberView& other)
+{
+    this->modulo(other);
+    return *this;
+}
+
+BigInt BigInt::operator+(const ConstNumberView& other) const
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.add(other, false);
+    return result;
+}
+
+BigInt BigInt::operator-(const ConstNumberView& other) const
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.add(other, true);
+    return result;
+}
+
+BigInt BigInt::operator*(const ConstNumberView& other) const
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.multiply(other);
+    return result;
+}
+
+BigInt BigInt::operator/(const ConstNumberView& other) const
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.divide(other);
+    return result;
+}
+
+BigInt BigInt::operator%(const ConstNumberView& other) const
+{
+    BigInt result(*this);
+    result.Widen(other.GetBitSize());
+    result.modulo(other);
+    return result;
+}
+
+// A view carries no invalid bits, so those of a Number operand are applied after the view overload
+void BigInt::add(const Number& other, bool subtract)
+{
+    size_t unknown = other.LowestInvalidBit();
+    add(ConstNumberView(other), subtract);
+    MarkInvalidFrom(unknown);
+}
+
+void BigInt::multiply(const Number& other)
+{
+    size_t unknown = other.LowestInvalidBit();
+    multiply(ConstNumberView(other));
+    MarkInvalidFrom(unknown);
+}
+
+void BigInt::divide(const Number& other)
+{
+    bool unknown = !other.IsValid();
+    divide(ConstNumberView(other));
+    if (unknown)
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+void BigInt::modulo(const Number& other)
+{
+    bool unknown = !other.IsValid();
+    modulo(ConstNumberView(other));
+    if (unknown)
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+void BigInt::add(const ConstNumberView& other, bool subtract)
+{
+    INSTRUMENT_SCOPE(subtract ? Instrument::Op::Subtract : Instrument::Op::Add, std::max(GetLimbCount(), other.GetLimbCount()));
+    // With auto-grow the operation runs one bit wider than either operand so it cannot overflow.
+    // Bit i of a sum depends only on bits 0..i, so everything from the lowest invalid bit up is invalid
+    size_t OriginalBitSize = BitSize;
+    size_t unknown = LowestInvalidBit();
+    size_t width = AutoGrow ? std::max(BitSize, other.GetBitSize()) + 1 : BitSize;
+    size_t NeedGroup = LimbOps::LimbCount(width);
+
+    // Whole-limb add / subtract, carry (borrow) propagated through the limb chain.
+    // An operand of another width (or in another layout) is sign-extended to this width first;
+    // that happens before any resize, since the view may point at this object's own storage
+    const Limb* b = other.GetBitSize() == width ? other.GetLimbs() : nullptr;
+    LimbOps::TempLimbs extended(b == nullptr ? NeedGroup : 0);
+    if (b == nullptr)
+    {
+        other.Load(extended.data(), NeedGroup);
+        b = extended.data();
+    }
+    Resize(width);
+
+    if (subtract)
+    {
+        LimbOps::Sub(Data, Data, b, NeedGroup);
+    }
+    else
+    {
+        LimbOps::Add(Data, Data, b, NeedGroup);
+    }
+    ClearUnusedBits();
+    FinishWidth(OriginalBitSize);
+    MarkInvalidFrom(unknown);
+}
+
+void BigInt::multiply(const ConstNumberView& other)
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Multiply, std::max(GetLimbCount(), other.GetLimbCount()));
+    size_t OriginalBitSize = BitSize;
+    size_t unknown = LowestInvalidBit();
+    size_t width = AutoGrow ? BitSize + other.GetBitSize() : BitSize;
+    LimbOps::TempLimbs b(LimbOps::LimbCount(width));
+    other.Load(b.data(), b.size());
+    Resize(width);
+
+    LimbOps::SignedMulLow(Data, Data, b.data(), BitSize);
+    FinishWidth(OriginalBitSize);
+    MarkInvalidFrom(unknown);
+}
+
+void BigInt::divide(const ConstNumberView& other)
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Divide, std::max(GetLimbCount(), other.GetLimbCount()));
+    // Division needs the whole divisor, so a wider divisor widens the dividend for the duration.
+    // Auto-grow adds one bit for the most negative value divided by -1
+    size_t OriginalBitSize = BitSize;
+    bool unknown = !IsValid();
+    size_t width = std::max(BitSize, other.GetBitSize()) + (AutoGrow ? 1 : 0);
+    LimbOps::TempLimbs b(LimbOps::LimbCount(width));
+    other.Load(b.data(), b.size());
+    Resize(width);
+
+    LimbOps::SignedDivRem(Data, nullptr, Data, b.data(), BitSize);
+    FinishWidth(OriginalBitSize);
+    if (unknown)
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+void BigInt::modulo(const ConstNumberView& other)
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Modulo, std::max(GetLimbCount(), other.GetLimbCount()));
+    // The remainder is never larger than the dividend, it always fits the original width
+    size_t OriginalBitSize = BitSize;
+    bool unknown = !IsValid();
+    size_t width = std::max(BitSize, other.GetBitSize());
+    LimbOps::TempLimbs b(LimbOps::LimbCount(width));
+    other.Load(b.data(), b.size());
+    Resize(width);
+
+    LimbOps::SignedDivRem(nullptr, Data, Data, b.data(), BitSize);
+    FinishWidth(OriginalBitSize);
+    if (unknown)
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+std::pair<BigInt, BigInt> BigInt::divmod(const ConstNumberView& other) const
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Divide, std::max(GetLimbCount(), other.GetLimbCount()));
+    size_t width = std::max(BitSize, other.GetBitSize());
+    BigInt dividend(*this);
+    dividend.Resize(width + (AutoGrow ? 1 : 0));
+    LimbOps::TempLimbs b(dividend.GetLimbCount());
+    other.Load(b.data(), b.size());
+
+    std::pair<BigInt, BigInt> result(dividend, dividend);
+    LimbOps::SignedDivRem(result.first.Data, result.second.Data, dividend.Data, b.data(), dividend.BitSize);
+    result.first.FinishWidth(width);
+    result.second.FinishWidth(width);
+    if (!IsValid())
+    {
+        result.first.MarkInvalidFrom(0);
+        result.second.MarkInvalidFrom(0);
+    }
+    return result;
+}
+
+std::pair<BigInt, BigInt> BigInt::divmod(const Number& other) const
+{
+    std::pair<BigInt, BigInt> result = divmod(ConstNumberView(other));
+    if (!other.IsValid())
+    {
+        result.first.MarkInvalidFrom(0);
+        result.second.MarkInvalidFrom(0);
+    }
+    return result;
+}
+
+void BigInt::SetScalar(std::uint64_t magnitude, bool negative)
+{
+    Limb limbs[2];
+    ScalarLimbs(limbs, magnitude, negative);
+    LimbOps::SignExtend(Data, GetLimbCount(), limbs, ScalarBits);
+    ClearUnusedBits();
+    MarkValid();
+}
+
+void BigInt::AddScalar(std::uint64_t magnitude, bool negative)
+{
+    if (AutoGrow)
+    {
+        Limb limbs[2];
+        ScalarLimbs(limbs, magnitude, negative);
+        add(ConstNumberView(limbs, ScalarBits), false);
+        return;
+    }
+
+    // Adding or subtracting one limb wraps modulo 2^BitSize whatever the width, and the carry
+    // (borrow) usually stops after the first limb
+    INSTRUMENT_SCOPE(negative ? Instrument::Op::Subtract : Instrument::Op::Add, GetLimbCount());
+    if (negative)
+    {
+        LimbOps::Sub1(Data, Data, GetLimbCount(), magnitude);
+    }
+    else
+    {
+        LimbOps::Add1(Data, Data, GetLimbCount(), magnitude);
+    }
+    ClearUnusedBits();
+    MarkInvalidFrom(LowestInvalidBit());
+}
+
+void BigInt::MultiplyScalar(std::uint64_t magnitude, bool negative)
+{
+    if (AutoGrow)
+    {
+        Limb limbs[2];
+        ScalarLimbs(limbs, magnitude, negative);
+        multiply(ConstNumberView(limbs, ScalarBits));
+        return;
+    }
+
+    // The truncated product of a two's-complement value and a single limb needs no sign handling
+    INSTRUMENT_SCOPE(Instrument::Op::Multiply, GetLimbCount());
+    LimbOps::Mul1(Data, Data, GetLimbCount(), magnitude);
+    if (negative)
+    {
+        LimbOps::Negate(Data, Data, GetLimbCount());
+    }
+    ClearUnusedBits();
+    MarkInvalidFrom(LowestInvalidBit());
+}
+
+void BigInt::DivideScalar(std::uint64_t magnitude, bool negative, bool remainder)
+{
+    if (magnitude == 0)
+    {
+        throw std::domain_error("Division by zero");
+    }
+    if (AutoGrow)
+    {
+        Limb limbs[2];
+        ScalarLimbs(limbs, magnitude, negative);
+        if (remainder)
+        {
+            modulo(ConstNumberView(limbs, ScalarBits));
+        }
+        else
+        {
+            divide(ConstNumberView(limbs, ScalarBits));
+        }
+        return;
+    }
+
+    // Divide the magnitude in place by the single limb, then restore the signs: the quotient
+    // rounds toward zero and the remainder takes the sign of the dividend
+    INSTRUMENT_SCOPE(remainder ? Instrument::Op::Modulo : Instrument::Op::Divide, GetLimbCount());
+    size_t NeedGroup = GetLimbCount();
+    bool dividendNegative = LimbOps::Magnitude(Data, Data, BitSize);
+    Limb rest = LimbOps::DivRem1(Data, Data, NeedGroup, magnitude);
+    if (remainder)
+    {
+        std::fill(Data, Data + NeedGroup, 0);
+        Data[0] = rest;
+    }
+    if (remainder ? dividendNegative : dividendNegative != negative)
+    {
+        LimbOps::Negate(Data, Data, NeedGroup);
+    }
+    ClearUnusedBits();
+    if (!IsValid())
+    {
+        MarkInvalidFrom(0);
+    }
+}
+
+int BigInt::CompareScalar(std::uint64_t magnitude, bool negative) const
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Compare, GetLimbCount());
+    bool thisNegative = GetBit(BitSize - 1) == 1;
+    if (thisNegative != negative)
+    {
+        return thisNegative ? -1 : 1;
+    }
+
+    // Same sign: compare both sign-extended to at least two limbs, from the top limb down
+    Limb scalar[2];
+    ScalarLimbs(scalar, magnitude, negative);
+    size_t NeedGroup = GetLimbCount();
+    Limb fill = thisNegative ? ~Limb(0) : 0;
+    for (size_t i = std::max<size_t>(NeedGroup, 2); i-- > 0;)
+    {
+        Limb word = fill;
+        if (i + 1 < NeedGroup)
+        {
+            word = Data[i];
+        }
+        else if (i + 1 == NeedGroup)
+        {
+            word = Data[i] | (fill & ~LimbOps::TopMask(BitSize));
+        }
+        Limb other = i < 2 ? scalar[i] : scalar[1];
+        if (word != other)
+        {
+            return word < other ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+void BigInt::SetAutoGrow(bool enable)
+{
+    AutoGrow = enable;
+}
+
+bool BigInt::GetAutoGrow() const
+{
+    return AutoGrow;
+}
+
+void BigInt::Resize(size_t NewBitSize)
+{
+    if (NewBitSize == 0)
+    {
+        throw std::invalid_argument("Bit size must be positive");
+    }
+    if (NewBitSize == BitSize)
+    {
+        return;
+    }
+
+    ResizeSignExtend(NewBitSize);
+}
+
+size_t BigInt::MinimalBitSize() const
+{
+    // The highest bit that differs from the sign bit, plus the sign bit itself
+    size_t NeedGroup = GetLimbCount();
+    if (NeedGroup == 0)
+    {
+        return 1;
+    }
+
+    Limb flip = GetBit(BitSize - 1) == 1 ? ~Limb(0) : 0;
+    for (size_t i = NeedGroup; i > 0; --i)
+    {
+        Limb word = Data[i - 1] ^ flip;
+        if (i == NeedGroup)
+        {
+            word &= LimbOps::TopMask(BitSize);
+        }
+        if (word != 0)
+        {
+            return i * LIMB_BITS - LimbOps::CountLeadingZeros(word) + 1;
+        }
+    }
+    return 1;
+}
+
+void BigInt::ShrinkToFit()
+{
+    Resize(MinimalBitSize());
+}
+
+void BigInt::Widen(size_t OtherBitSize)
+{
+    // Binary operators produce the wider of the two widths
+    if (OtherBitSize > BitSize)
+    {
+        Resize(OtherBitSize);
+    }
+}
+
+void BigInt::FinishWidth(size_t OriginalBitSize)
+{
+    // Without auto-grow the result wraps back to the original width; with it the width
+    // only grows, by whole limbs, when the value no longer fits
+    size_t width = OriginalBitSize;
+    if (AutoGrow)
+    {
+        size_t needed = MinimalBitSize();
+        if (needed > width)
+        {
+            width = LimbOps::LimbCount(needed) * LIMB_BITS;
+        }
+    }
+    Resize(width);
+}
@@ -1,31 +1,383 @@
-#pragma once
-#include "Number.h"
-#include <iostream>
-#include <string>
-
-class BigInt :public Number
-{
-public:
-	BigInt(const char* num,size_t BitSize);
-	BigInt(const char* num, size_t BitSize,int radix);
-	BigInt(int num, size_t BitSize);
-
-	std::string ToString() const;
-
-	// 
-	BigInt& operator+=(const Number& other);
-	BigInt operator+(const Number& other) const;
-	BigInt& operator+=(int value);
-	BigInt operator+(int value) const;
-
-
-	virtual ~BigInt() override = default;
-
-private:
-	void StringToBinary(const std::string& numberStr);
-
-protected:
-	void add(const Number& other, bool subtract);
-	void multiply(const Number& other);
-	void divide(const Number& other);
-};
\ No newline at end of file
+#pragma once
+#include "Number.h"
+#include "NumberView.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace Expr
+{
+	template <class Derived>
+	struct Expression;
+}
+
+class BigInt :public Number
+{
+	// 只接受机器整数（int、int64_t、uint64_t、size_t 等）的模板参数
+	template <class T>
+	using IfInteger = typename std::enable_if<std::is_integral<T>::value, int>::type;
+
+public:
+	BigInt(const char* num,size_t BitSize);
+	// radix 为 2~36，2/8/16/32 进制按位直接映射，数字可用大小写字母，前面可带 '-' 或 '+'（符号后必须有数字）
+	BigInt(const char* num, size_t BitSize,int radix);
+	template <class T, IfInteger<T> = 0>
+	BigInt(T num, size_t BitSize);   // 按 BitSize 位回绕
+	BigInt(const Limb* limbs, size_t BitSize);  // 从 LimbCount(BitSize) 个字（补码，低位字在前）构造
+	explicit BigInt(const ConstNumberView& view);  // 复制视图的值，位宽与视图相同
+	BigInt(const BigInt& other) = default;
+	BigInt(BigInt&& other) noexcept = default;
+	// 对表达式模板求值（见 Expression.h），下面的赋值与 +=、-= 同样直接写入本对象的存储
+	template <class E>
+	BigInt(const Expr::Expression<E>& expression);
+
+	BigInt& operator=(const BigInt& other) = default;
+	BigInt& operator=(BigInt&& other) noexcept = default;
+	template <class E>
+	BigInt& operator=(const Expr::Expression<E>& expression);
+
+	std::string ToString() const;
+	// radix 为 2~36，字母用小写，负数前面带 '-'
+	std::string ToString(int radix) const;
+
+	// 与 std::to_chars 相同：写入 [first, last) 并返回写到的位置，不写 '\0'。
+	// 空间不够时返回 {last, std::errc::value_too_large}，缓冲区内容不确定
+	struct ToCharsResult
+	{
+		char* ptr;
+		std::errc ec;
+	};
+	ToCharsResult ToChars(char* first, char* last, int radix = 10) const;
+	// 当前位宽下 ToString / ToChars 输出长度的上界（含符号），只与位宽有关，可以用来预先分配缓冲区
+	size_t MaxStringLength(int radix = 10) const;
+	// 按块写到 sink（每块不超过 4KB），不生成完整的字符串，适合输出很大的数或频繁写日志
+	void Write(const LimbOps::TextSink& sink, int radix = 10, bool uppercase = false) const;
+	void WriteMagnitude(const LimbOps::TextSink& sink, int radix = 10, bool uppercase = false) const;  // 只写绝对值
+
+	// 运算符重载
+	BigInt& operator+=(const Number& other);
+	BigInt operator+(const Number& other) const&;
+	BigInt operator+(const Number& other) &&;
+	template <class E>
+	BigInt& operator+=(const Expr::Expression<E>& expression);
+	using Number::operator-=;
+	template <class E>
+	BigInt& operator-=(const Expr::Expression<E>& expression);
+	BigInt operator-(const Number& other) const&;
+	BigInt operator-(const Number& other) &&;
+	BigInt operator*(const Number& other) const&;
+	BigInt operator*(const Number& other) &&;
+	BigInt operator/(const Number& other) const&;
+	BigInt operator/(const Number& other) &&;
+	BigInt operator%(const Number& other) const&;
+	BigInt operator%(const Number& other) &&;
+
+	// 外部存储的视图（见 NumberView.h）可以直接作为操作数，不需要先复制成 BigInt
+	using Number::operator*=;
+	using Number::operator/=;
+	using Number::operator%=;
+	BigInt& operator+=(const ConstNumberView& other);
+	BigInt& operator-=(const ConstNumberView& other);
+	BigInt& operator*=(const ConstNumberView& other);
+	BigInt& operator/=(const ConstNumberView& other);
+	BigInt& operator%=(const ConstNumberView& other);
+	BigInt operator+(const ConstNumberView& other) const;
+	BigInt operator-(const ConstNumberView& other) const;
+	BigInt operator*(const ConstNumberView& other) const;
+	BigInt operator/(const ConstNumberView& other) const;
+	BigInt operator%(const ConstNumberView& other) const;
+
+	// 与 int64_t、uint64_t 等机器整数的运算：直接在本对象的字上完成，不构造临时 BigInt，不转换字符串，
+	// 也不分配内存。结果保持本对象的位宽并按它回绕（开启自动扩展时与 Number 操作数的规则相同）。
+	// 除数为0时抛出 std::domain_error
+	template <class T, IfInteger<T> = 0>
+	BigInt& operator+=(T value);
+	template <class T, IfInteger<T> = 0>
+	BigInt& operator-=(T value);
+	template <class T, IfInteger<T> = 0>
+	BigInt& operator*=(T value);
+	template <class T, IfInteger<T> = 0>
+	BigInt& operator/=(T value);
+	template <class T, IfInteger<T> = 0>
+	BigInt& operator%=(T value);
+	template <class T, IfInteger<T> = 0>
+	BigInt operator+(T value) const&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator+(T value) &&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator-(T value) const&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator-(T value) &&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator*(T value) const&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator*(T value) &&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator/(T value) const&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator/(T value) &&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator%(T value) const&;
+	template <class T, IfInteger<T> = 0>
+	BigInt operator%(T value) &&;
+
+	using Number::Compare;
+	using Number::operator==;
+	using Number::operator!=;
+	using Number::operator<;
+	using Number::operator<=;
+	using Number::operator>;
+	using Number::operator>=;
+	template <class T, IfInteger<T> = 0>
+	int Compare(T value) const;   // 按数值比较，返回 -1 / 0 / 1
+	template <class T, IfInteger<T> = 0>
+	bool operator==(T value) const;
+	template <class T, IfInteger<T> = 0>
+	bool operator!=(T value) const;
+	template <class T, IfInteger<T> = 0>
+	bool operator<(T value) const;
+	template <class T, IfInteger<T> = 0>
+	bool operator<=(T value) const;
+	template <class T, IfInteger<T> = 0>
+	bool operator>(T value) const;
+	template <class T, IfInteger<T> = 0>
+	bool operator>=(T value) const;
+#if NUMBER_HAS_THREE_WAY_COMPARE
+	using Number::operator<=>;
+	template <class T, IfInteger<T> = 0>
+	std::strong_ordering operator<=>(T value) const;
+#endif
+
+	// 同时求商和余数：商向0取整，余数与被除数同号。除数为0时抛出 std::domain_error
+	std::pair<BigInt, BigInt> divmod(const ConstNumberView& other) const;
+	std::pair<BigInt, BigInt> divmod(const Number& other) const;
+
+	// 运算允许两个操作数的位宽不同，较窄的一方先符号扩展：a + b 等二元运算（以及 divmod）的结果
+	// 取两者中较大的位宽，a += b 等复合赋值保持 a 的位宽并按该位宽回绕。
+	// 开启自动扩展后，结果放不下时位宽按整字增长而不是回绕（二元运算的结果沿用左操作数的设置，
+	// 表达式模板不受影响）
+	void SetAutoGrow(bool enable);
+	bool GetAutoGrow() const;
+
+	void Resize(size_t NewBitSize);   // 符号扩展或截断（回绕）到 NewBitSize 位
+	size_t MinimalBitSize() const;    // 能表示当前值的最小位宽（含符号位）
+	void ShrinkToFit();               // 缩小到 MinimalBitSize() 位
+
+
+	virtual ~BigInt() override = default;
+
+private:
+	bool AutoGrow = false;
+
+	void StringToBinary(const char* num, size_t length, int radix);
+	void Widen(size_t OtherBitSize);
+	void FinishWidth(size_t OriginalBitSize);
+
+	// 机器整数按 (绝对值, 是否为负) 传给下面的非模板函数，int64_t 的最小值同样适用
+	template <class T>
+	static bool ScalarNegative(T value);
+	template <class T>
+	static std::uint64_t ScalarMagnitude(T value);
+	void SetScalar(std::uint64_t magnitude, bool negative);
+	void AddScalar(std::uint64_t magnitude, bool negative);
+	void MultiplyScalar(std::uint64_t magnitude, bool negative);
+	void DivideScalar(std::uint64_t magnitude, bool negative, bool remainder);
+	int CompareScalar(std::uint64_t magnitude, bool negative) const;
+
+protected:
+	void add(const Number& other, bool subtract);
+	void multiply(const Number& other);
+	void divide(const Number& other);
+	void modulo(const Number& other);
+	void add(const ConstNumberView& other, bool subtract);
+	void multiply(const ConstNumberView& other);
+	void divide(const ConstNumberView& other);
+	void modulo(const ConstNumberView& other);
+};
+
+// 按流的 dec / hex / oct、uppercase、showbase、showpos 输出。设置了宽度时按 left / right 补齐，
+// internal 与内置整数一样把填充字符放在符号、基数前缀与数字之间
+std::ostream& operator<<(std::ostream& os, const BigInt& value);
+
+template <class T>
+bool BigInt::ScalarNegative(T value)
+{
+	return std::is_signed<T>::value && value < T(0);
+}
+
+template <class T>
+std::uint64_t BigInt::ScalarMagnitude(T value)
+{
+	std::uint64_t bits = static_cast<std::uint64_t>(value);
+	return ScalarNegative(value) ? 0 - bits : bits;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt::BigInt(T num, size_t BitSize) :Number(BitSize)
+{
+	this->NumberType = Type::Integer;
+	SetScalar(ScalarMagnitude(num), ScalarNegative(num));
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt& BigInt::operator+=(T value)
+{
+	AddScalar(ScalarMagnitude(value), ScalarNegative(value));
+	return *this;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt& BigInt::operator-=(T value)
+{
+	AddScalar(ScalarMagnitude(value), !ScalarNegative(value));
+	return *this;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt& BigInt::operator*=(T value)
+{
+	MultiplyScalar(ScalarMagnitude(value), ScalarNegative(value));
+	return *this;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt& BigInt::operator/=(T value)
+{
+	DivideScalar(ScalarMagnitude(value), ScalarNegative(value), false);
+	return *this;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt& BigInt::operator%=(T value)
+{
+	DivideScalar(ScalarMagnitude(value), ScalarNegative(value), true);
+	return *this;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator+(T value) const&
+{
+	BigInt result = *this;
+	result += value;
+	return result;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator+(T value) &&
+{
+	*this += value;
+	return std::move(*this);
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator-(T value) const&
+{
+	BigInt result = *this;
+	result -= value;
+	return result;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator-(T value) &&
+{
+	*this -= value;
+	return std::move(*this);
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator*(T value) const&
+{
+	BigInt result = *this;
+	result *= value;
+	return result;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator*(T value) &&
+{
+	*this *= value;
+	return std::move(*this);
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator/(T value) const&
+{
+	BigInt result = *this;
+	result /= value;
+	return result;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator/(T value) &&
+{
+	*this /= value;
+	return std::move(*this);
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator%(T value) const&
+{
+	BigInt result = *this;
+	result %= value;
+	return result;
+}
+
+template <class T, BigInt::IfInteger<T>>
+BigInt BigInt::operator%(T value) &&
+{
+	*this %= value;
+	return std::move(*this);
+}
+
+template <class T, BigInt::IfInteger<T>>
+int BigInt::Compare(T value) const
+{
+	return CompareScalar(ScalarMagnitude(value), ScalarNegative(value));
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator==(T value) const
+{
+	return Compare(value) == 0;
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator!=(T value) const
+{
+	return Compare(value) != 0;
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator<(T value) const
+{
+	return Compare(value) < 0;
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator<=(T value) const
+{
+	return Compare(value) <= 0;
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator>(T value) const
+{
+	return Compare(value) > 0;
+}
+
+template <class T, BigInt::IfInteger<T>>
+bool BigInt::operator>=(T value) const
+{
+	return Compare(value) >= 0;
+}
+
+#if NUMBER_HAS_THREE_WAY_COMPARE
+template <class T, BigInt::IfInteger<T>>
+std::strong_ordering BigInt::operator<=>(T value) const
+{
+	return Compare(value) <=> 0;
+}
+#endif
@@ -0,0 +1,316 @@
+#include "BigIntBatch.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // 加减法按块处理元素，每块的进位/借位缓冲区放在栈上，且块内数据留在缓存中
+    const size_t BlockSize = 256;
+
+    // 不超过该字数时乘法直接用截断的 basecase，否则调用 LimbOps::MulLow
+    const size_t BasecaseMulLimbs = 16;
+}
+
+BigIntBatch::BigIntBatch(size_t BitSize, size_t Count)
+    :BitSize(BitSize), LimbCount(LimbOps::LimbCount(BitSize)), Count(Count), Limbs(LimbCount * Count, 0)
+{
+}
+
+BigIntBatch::BigIntBatch(const std::vector<BigInt>& values)
+    :BitSize(0), LimbCount(0), Count(values.size())
+{
+    if (values.empty())
+    {
+        throw std::invalid_argument("Batch is empty");
+    }
+
+    BitSize = values[0].GetBitSize();
+    LimbCount = values[0].GetLimbCount();
+    Limbs.assign(LimbCount * Count, 0);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        Set(i, values[i]);
+    }
+}
+
+size_t BigIntBatch::GetBitSize() const
+{
+    return BitSize;
+}
+
+size_t BigIntBatch::GetLimbCount() const
+{
+    return LimbCount;
+}
+
+size_t BigIntBatch::size() const
+{
+    return Count;
+}
+
+Limb* BigIntBatch::Row(size_t limb)
+{
+    return Limbs.data() + limb * Count;
+}
+
+const Limb* BigIntBatch::Row(size_t limb) const
+{
+    return Limbs.data() + limb * Count;
+}
+
+void BigIntBatch::Set(size_t index, const BigInt& value)
+{
+    if (index >= Count)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    if (value.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+
+    const Limb* source = value.GetData();
+    for (size_t j = 0; j < LimbCount; ++j)
+    {
+        Row(j)[index] = source[j];
+    }
+}
+
+BigInt BigIntBatch::Get(size_t index) const
+{
+    if (index >= Count)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    LimbOps::TempLimbs value(LimbCount);
+    for (size_t j = 0; j < LimbCount; ++j)
+    {
+        value[j] = Row(j)[index];
+    }
+    return BigInt(value.data(), BitSize);
+}
+
+std::vector<BigInt> BigIntBatch::ToBigInts() const
+{
+    std::vector<BigInt> values;
+    values.reserve(Count);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        values.push_back(Get(i));
+    }
+    return values;
+}
+
+BigIntBatch& BigIntBatch::operator+=(const BigIntBatch& other)
+{
+    CheckShape(other);
+
+    Limb carry[BlockSize];
+    for (size_t start = 0; start < Count; start += BlockSize)
+    {
+        size_t length = std::min(BlockSize, Count - start);
+        std::fill_n(carry, length, 0);
+        for (size_t j = 0; j < LimbCount; ++j)
+        {
+            Limb* r = Row(j) + start;
+            const Limb* b = other.Row(j) + start;
+            for (size_t i = 0; i < length; ++i)
+            {
+                Limb a = r[i];
+                Limb s = a + b[i];
+                Limb t = s + carry[i];
+                carry[i] = (s < a) | (t < s);
+                r[i] = t;
+            }
+        }
+    }
+
+    ClearUnusedBits();
+    return *this;
+}
+
+BigIntBatch& BigIntBatch::operator-=(const BigIntBatch& other)
+{
+    CheckShape(other);
+
+    Limb borrow[BlockSize];
+    for (size_t start = 0; start < Count; start += BlockSize)
+    {
+        size_t length = std::min(BlockSize, Count - start);
+        std::fill_n(borrow, length, 0);
+        for (size_t j = 0; j < LimbCount; ++j)
+        {
+            Limb* r = Row(j) + start;
+            const Limb* b = other.Row(j) + start;
+            for (size_t i = 0; i < length; ++i)
+            {
+                Limb a = r[i];
+                Limb d = a - b[i];
+                Limb t = d - borrow[i];
+                borrow[i] = (a < b[i]) | (d < borrow[i]);
+                r[i] = t;
+            }
+        }
+    }
+
+    ClearUnusedBits();
+    return *this;
+}
+
+BigIntBatch& BigIntBatch::operator*=(const BigIntBatch& other)
+{
+    CheckShape(other);
+
+    // 64x64->128 位乘法没有对应的向量指令，逐元素取出各字后做截断乘法（补码低位与符号无关）
+    LimbOps::TempLimbs a(LimbCount), b(LimbCount), r(LimbCount);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        for (size_t j = 0; j < LimbCount; ++j)
+        {
+            a[j] = Row(j)[i];
+            b[j] = other.Row(j)[i];
+        }
+
+        if (LimbCount <= BasecaseMulLimbs)
+        {
+            LimbOps::Mul1(r.data(), b.data(), LimbCount, a[0]);
+            for (size_t j = 1; j < LimbCount; ++j)
+            {
+                LimbOps::AddMul1(r.data() + j, b.data(), LimbCount - j, a[j]);
+            }
+        }
+        else
+        {
+            LimbOps::MulLow(r.data(), a.data(), b.data(), LimbCount);
+        }
+
+        for (size_t j = 0; j < LimbCount; ++j)
+        {
+            Row(j)[i] = r[j];
+        }
+    }
+
+    ClearUnusedBits();
+    return *this;
+}
+
+BigIntBatch& BigIntBatch::operator&=(const BigIntBatch& other)
+{
+    CheckShape(other);
+    LimbOps::And(Limbs.data(), Limbs.data(), other.Limbs.data(), Limbs.size());
+    return *this;
+}
+
+BigIntBatch& BigIntBatch::operator|=(const BigIntBatch& other)
+{
+    CheckShape(other);
+    LimbOps::Or(Limbs.data(), Limbs.data(), other.Limbs.data(), Limbs.size());
+    return *this;
+}
+
+BigIntBatch& BigIntBatch::operator^=(const BigIntBatch& other)
+{
+    CheckShape(other);
+    LimbOps::Xor(Limbs.data(), Limbs.data(), other.Limbs.data(), Limbs.size());
+    return *this;
+}
+
+BigIntBatch BigIntBatch::operator+(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result += other;
+    return result;
+}
+
+BigIntBatch BigIntBatch::operator-(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result -= other;
+    return result;
+}
+
+BigIntBatch BigIntBatch::operator*(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result *= other;
+    return result;
+}
+
+BigIntBatch BigIntBatch::operator&(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result &= other;
+    return result;
+}
+
+BigIntBatch BigIntBatch::operator|(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result |= other;
+    return result;
+}
+
+BigIntBatch BigIntBatch::operator^(const BigIntBatch& other) const
+{
+    BigIntBatch result(*this);
+    result ^= other;
+    return result;
+}
+
+void BigIntBatch::Compare(const BigIntBatch& other, signed char* result) const
+{
+    CheckShape(other);
+
+    // 最高字翻转符号位后按无符号比较就是有符号的顺序，其余字按无符号比较。
+    // 从最高字往下，已经分出大小的元素保持原结果
+    std::fill_n(result, Count, 0);
+    Limb sign = Limb(1) << ((BitSize - 1) % LIMB_BITS);
+    for (size_t j = LimbCount; j > 0; --j)
+    {
+        const Limb* a = Row(j - 1);
+        const Limb* b = other.Row(j - 1);
+        Limb flip = j == LimbCount ? sign : 0;
+        for (size_t i = 0; i < Count; ++i)
+        {
+            Limb x = a[i] ^ flip;
+            Limb y = b[i] ^ flip;
+            signed char order = static_cast<signed char>((x > y) - (x < y));
+            result[i] = result[i] != 0 ? result[i] : order;
+        }
+    }
+}
+
+std::vector<signed char> BigIntBatch::Compare(const BigIntBatch& other) const
+{
+    std::vector<signed char> result(Count);
+    Compare(other, result.data());
+    return result;
+}
+
+void BigIntBatch::CheckShape(const BigIntBatch& other) const
+{
+    if (BitSize != other.BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+    if (Count != other.Count)
+    {
+        throw std::invalid_argument("Batch sizes do not match");
+    }
+}
+
+void BigIntBatch::ClearUnusedBits()
+{
+    Limb mask = LimbOps::TopMask(BitSize);
+    if (mask == ~Limb(0) || LimbCount == 0)
+    {
+        return;
+    }
+
+    Limb* top = Row(LimbCount - 1);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        top[i] &= mask;
+    }
+}
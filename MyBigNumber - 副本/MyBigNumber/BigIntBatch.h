@@ -0,0 +1,53 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include <vector>
+
+// 一组位宽相同的整数，按字优先（SoA）连续存放：第 j 个字的所有元素放在一起，
+// 即 Limbs[j * Count + i] 是第 i 个数的第 j 个字。逐元素运算时内层循环沿元素方向，
+// 相邻元素之间没有依赖，编译器可以直接向量化；进位按元素保存在一小块缓冲区里
+class BigIntBatch
+{
+public:
+	BigIntBatch(size_t BitSize, size_t Count);
+	explicit BigIntBatch(const std::vector<BigInt>& values);  // values 不能为空，位宽必须一致
+
+	size_t GetBitSize() const;
+	size_t GetLimbCount() const;
+	size_t size() const;
+
+	void Set(size_t index, const BigInt& value);
+	BigInt Get(size_t index) const;
+	std::vector<BigInt> ToBigInts() const;
+
+	// 第 limb 个字的一行，共 size() 个元素
+	Limb* Row(size_t limb);
+	const Limb* Row(size_t limb) const;
+
+	// 逐元素运算，结果按 BitSize 位回绕（与 BigInt 相同）
+	BigIntBatch& operator+=(const BigIntBatch& other);
+	BigIntBatch& operator-=(const BigIntBatch& other);
+	BigIntBatch& operator*=(const BigIntBatch& other);
+	BigIntBatch& operator&=(const BigIntBatch& other);
+	BigIntBatch& operator|=(const BigIntBatch& other);
+	BigIntBatch& operator^=(const BigIntBatch& other);
+	BigIntBatch operator+(const BigIntBatch& other) const;
+	BigIntBatch operator-(const BigIntBatch& other) const;
+	BigIntBatch operator*(const BigIntBatch& other) const;
+	BigIntBatch operator&(const BigIntBatch& other) const;
+	BigIntBatch operator|(const BigIntBatch& other) const;
+	BigIntBatch operator^(const BigIntBatch& other) const;
+
+	// 逐元素有符号比较，result[i] 为 -1 / 0 / 1
+	void Compare(const BigIntBatch& other, signed char* result) const;
+	std::vector<signed char> Compare(const BigIntBatch& other) const;
+
+private:
+	size_t BitSize;
+	size_t LimbCount;
+	size_t Count;
+	std::vector<Limb> Limbs;
+
+	void CheckShape(const BigIntBatch& other) const;
+	void ClearUnusedBits();
+};
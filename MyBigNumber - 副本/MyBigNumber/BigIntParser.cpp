@@ -0,0 +1,311 @@
+#include "BigIntParser.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const size_t ReadBufferSize = size_t(1) << 16;
+    // 一块为 2^BlockLevel 个单字能容纳的数字组，十进制为 19*512 位，转换后约500个字
+    const size_t BlockLevel = 9;
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // 字符对应的数值，不是合法数字时返回 -1
+    int DigitValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    std::vector<Limb> Product(const std::vector<Limb>& a, const std::vector<Limb>& b)
+    {
+        std::vector<Limb> result(a.size() + b.size());
+        LimbOps::Mul(result.data(), a.data(), a.size(), b.data(), b.size());
+        result.resize(LimbOps::Normalized(result.data(), result.size()));
+        return result;
+    }
+}
+
+BigIntParser::BigIntParser(int radix) :Radix(radix), BitsPerDigit(0), Negative(false), SeenSign(false), Digits(0)
+{
+    if (radix < 2 || radix > 36)
+    {
+        throw std::invalid_argument("Radix must be between 2 and 36");
+    }
+
+    // 每个数字最多占 ceil(log2(radix)) 位
+    unsigned maxBits = 1;
+    while ((1 << maxBits) < radix)
+    {
+        ++maxBits;
+    }
+    if ((radix & (radix - 1)) == 0)
+    {
+        BitsPerDigit = maxBits;
+    }
+
+    size_t chunkDigits = 1;
+    for (Limb chunkBase = static_cast<Limb>(radix); chunkBase <= ~Limb(0) / static_cast<Limb>(radix); chunkBase *= static_cast<Limb>(radix))
+    {
+        ++chunkDigits;
+    }
+    BlockDigits = chunkDigits << BlockLevel;
+    BlockLimbs = BlockDigits * maxBits / LIMB_BITS + 1;
+    Pending.reserve(BlockDigits);
+}
+
+void BigIntParser::Feed(const char* text, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        char c = text[i];
+        if (IsSpace(c))
+        {
+            continue;
+        }
+        if ((c == '-' || c == '+') && !SeenSign && Digits == 0)
+        {
+            Negative = c == '-';
+            SeenSign = true;
+            continue;
+        }
+
+        int value = DigitValue(c);
+        if (value < 0 || value >= Radix)
+        {
+            throw std::invalid_argument("Invalid digit for radix");
+        }
+        Pending.push_back(c);
+        ++Digits;
+        if (Pending.size() == BlockDigits)
+        {
+            FlushBlock();
+        }
+    }
+}
+
+void BigIntParser::Feed(const std::string& text)
+{
+    Feed(text.data(), text.size());
+}
+
+void BigIntParser::ReadFrom(std::istream& input)
+{
+    std::vector<char> buffer(ReadBufferSize);
+    while (input)
+    {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        Feed(buffer.data(), static_cast<size_t>(input.gcount()));
+    }
+    if (input.bad())
+    {
+        throw std::runtime_error("Cannot read number text");
+    }
+}
+
+void BigIntParser::ReadFrom(int descriptor)
+{
+    std::vector<char> buffer(ReadBufferSize);
+    for (;;)
+    {
+#if defined(_WIN32)
+        int count = _read(descriptor, buffer.data(), static_cast<unsigned>(buffer.size()));
+#else
+        ssize_t count = read(descriptor, buffer.data(), buffer.size());
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+        if (count < 0)
+        {
+            throw std::runtime_error("Cannot read number text");
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        Feed(buffer.data(), static_cast<size_t>(count));
+    }
+}
+
+size_t BigIntParser::DigitCount() const
+{
+    return Digits;
+}
+
+BigInt BigIntParser::Finish(size_t BitSize)
+{
+    bool negative = Negative;
+    std::vector<Limb> value = TakeValue();
+    value.resize(std::max(value.size(), LimbOps::LimbCount(BitSize)), 0);
+
+    BigInt result(value.data(), BitSize);
+    if (negative)
+    {
+        result.ToNegative();
+    }
+    return result;
+}
+
+BigInt BigIntParser::Finish()
+{
+    bool negative = Negative;
+    std::vector<Limb> value = TakeValue();
+    size_t BitSize = LimbOps::BitLength(value.data(), value.size()) + 1;
+    value.resize(LimbOps::LimbCount(BitSize), 0);
+
+    BigInt result(value.data(), BitSize);
+    if (negative)
+    {
+        result.ToNegative();
+    }
+    return result;
+}
+
+void BigIntParser::Reset()
+{
+    Negative = false;
+    SeenSign = false;
+    Digits = 0;
+    Pending.clear();
+    Parts.clear();
+}
+
+std::vector<Limb> BigIntParser::Convert(const char* digits, size_t length) const
+{
+    std::vector<Limb> value(BlockLimbs);
+    LimbOps::FromString(value.data(), value.size(), digits, length, Radix);
+    value.resize(LimbOps::Normalized(value.data(), value.size()));
+    return value;
+}
+
+void BigIntParser::FlushBlock()
+{
+    Part part;
+    part.Value = Convert(Pending.data(), Pending.size());
+    part.Level = 0;
+    Pending.clear();
+
+    // 与前一部分同级时合并成高一级，和二进制计数器的进位相同
+    while (!Parts.empty() && Parts.back().Level == part.Level)
+    {
+        part.Value = Combine(Parts.back().Value, part.Value, BlockDigits << part.Level);
+        ++part.Level;
+        Parts.pop_back();
+    }
+    Parts.push_back(std::move(part));
+}
+
+std::vector<Limb> BigIntParser::Combine(const std::vector<Limb>& high, const std::vector<Limb>& low, size_t lowDigits)
+{
+    std::vector<Limb> result;
+    if (BitsPerDigit != 0)
+    {
+        // 2 的幂进制：high 左移后直接与 low 拼接
+        size_t shift = lowDigits * BitsPerDigit;
+        result.assign(high.size() + shift / LIMB_BITS + 1, 0);
+        std::copy(high.begin(), high.end(), result.begin());
+        LimbOps::ShiftLeft(result.data(), result.data(), result.size(), shift);
+        for (size_t i = 0; i < low.size(); ++i)
+        {
+            result[i] |= low[i];
+        }
+    }
+    else
+    {
+        const std::vector<Limb>& power = Power(lowDigits);
+        result.assign(high.size() + power.size() + 1, 0);
+        LimbOps::Mul(result.data(), high.data(), high.size(), power.data(), power.size());
+        Limb carry = LimbOps::Add(result.data(), result.data(), low.data(), low.size());
+        LimbOps::Add1(result.data() + low.size(), result.data() + low.size(), result.size() - low.size(), carry);
+    }
+    result.resize(LimbOps::Normalized(result.data(), result.size()));
+    return result;
+}
+
+const std::vector<Limb>& BigIntParser::Power(size_t digits)
+{
+    // 不足一块的只有最后剩下的数字，单独计算
+    if (digits < BlockDigits)
+    {
+        TailPower = RadixPower(digits);
+        return TailPower;
+    }
+
+    size_t level = 0;
+    while ((BlockDigits << level) < digits)
+    {
+        ++level;
+    }
+    if (Powers.empty())
+    {
+        Powers.push_back(RadixPower(BlockDigits));
+    }
+    while (Powers.size() <= level)
+    {
+        Powers.push_back(Product(Powers.back(), Powers.back()));
+    }
+    return Powers[level];
+}
+
+std::vector<Limb> BigIntParser::RadixPower(size_t digits) const
+{
+    std::vector<Limb> result(1, 1);
+    std::vector<Limb> base(1, static_cast<Limb>(Radix));
+    for (size_t exponent = digits; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+        {
+            result = Product(result, base);
+        }
+        if (exponent > 1)
+        {
+            base = Product(base, base);
+        }
+    }
+    return result;
+}
+
+std::vector<Limb> BigIntParser::TakeValue()
+{
+    if (Digits == 0)
+    {
+        throw std::invalid_argument("No digits to parse");
+    }
+
+    // 从最高的部分开始依次拼接，各部分的规模逐个减半，最后是不满一块的数字
+    std::vector<Limb> value;
+    for (Part& part : Parts)
+    {
+        value = value.empty() ? std::move(part.Value) : Combine(value, part.Value, BlockDigits << part.Level);
+    }
+    if (!Pending.empty())
+    {
+        std::vector<Limb> tail = Convert(Pending.data(), Pending.size());
+        value = value.empty() ? std::move(tail) : Combine(value, tail, Pending.size());
+    }
+    Reset();
+    return value;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+// 增量解析很长的整数文本，文本可以分多次交给 Feed，或者直接从流、文件描述符读取，不需要先把整个文本读进内存。
+// 格式与 BigInt(const char*, BitSize, radix) 相同（可带 '-' 或 '+'，符号后必须有数字），不同之处是数字前后和
+// 数字之间的空白被忽略，所以按行或按组排版的常数表可以直接读入；另外没有任何数字（包括空输入）时 Finish 抛出异常，
+// 而 BigInt 把空字符串解析为0。
+//
+// 文本每满一块（十进制为 19*512 位）就转换成二进制，相同规模的相邻部分像二进制计数器进位一样两两合并：
+// high * radix^(low 的位数) + low，所需的幂逐级平方得到并缓存。每个数字只参与 O(log n) 次合并，
+// 总开销与一次同规模的乘法同阶，远低于逐位累加的平方复杂度。缓冲的文本不超过一块，
+// 其余内存与结果的规模成正比。抛出异常后解析器的状态不确定，需要 Reset 后才能继续使用
+class BigIntParser
+{
+public:
+	explicit BigIntParser(int radix = 10);   // radix 为 2~36
+
+	BigIntParser(const BigIntParser&) = delete;
+	BigIntParser& operator=(const BigIntParser&) = delete;
+
+	// 非法字符抛出 std::invalid_argument
+	void Feed(const char* text, size_t length);
+	void Feed(const std::string& text);
+	// 读到流结束（或文件描述符读到文件末尾），描述符不会被关闭。读取出错时抛出 std::runtime_error
+	void ReadFrom(std::istream& input);
+	void ReadFrom(int descriptor);
+
+	size_t DigitCount() const;   // 目前读入的数字个数
+
+	// 取得结果并回到初始状态（缓存的幂保留，解析下一个数时继续使用）。没有读入任何数字时抛出 std::invalid_argument
+	BigInt Finish(size_t BitSize);   // 按 BitSize 位回绕
+	BigInt Finish();                 // 位宽为绝对值的位数加一位符号位
+	void Reset();
+
+private:
+	// 已转换的部分，高位在前。Level 为 k 的部分正好由 BlockDigits * 2^k 个数字转换而来，Level 自前向后严格递减
+	struct Part
+	{
+		std::vector<Limb> Value;
+		size_t Level;
+	};
+
+	int Radix;
+	unsigned BitsPerDigit;   // 2 的幂进制每个数字的位数，合并时直接移位；其他进制为0
+	size_t BlockDigits;
+	size_t BlockLimbs;       // 一块数字转换后最多占用的字数
+	bool Negative;
+	bool SeenSign;
+	size_t Digits;
+	std::string Pending;     // 还不满一块的数字
+	std::vector<Part> Parts;
+	std::vector<std::vector<Limb>> Powers;   // Powers[k] = radix^(BlockDigits * 2^k)
+	std::vector<Limb> TailPower;
+
+	std::vector<Limb> Convert(const char* digits, size_t length) const;
+	void FlushBlock();
+	// high * radix^lowDigits + low，low 小于 radix^lowDigits
+	std::vector<Limb> Combine(const std::vector<Limb>& high, const std::vector<Limb>& low, size_t lowDigits);
+	const std::vector<Limb>& Power(size_t digits);
+	std::vector<Limb> RadixPower(size_t digits) const;
+	std::vector<Limb> TakeValue();
+};
@@ -0,0 +1,641 @@
+#include "LimbOps.h"
+#include <algorithm>
+
+// 位运算与移位：标量实现 + SSE2 / AVX2 / AVX-512 实现，启动时按 CPUID 选择。
+// 按位查询（1的个数、查找下一个1、按位段读写）也在这里，1的个数在 CPU 支持时使用 POPCNT。
+// 加减法的进位链已经由 _addcarry_u64 / _subborrow_u64 逐字完成，向量化反而更慢，这里不做
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define LIMBOPS_X86_SIMD
+#endif
+
+#if defined(__GNUC__)
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+// 少于该字数时直接用标量循环，省去间接调用
+#ifndef SIMD_MIN_LIMBS
+#define SIMD_MIN_LIMBS 8
+#endif
+
+namespace
+{
+    // ShiftRight 的核心：r[i] = (src[i] >> bits) | (src[i+1] << (64-bits))，i < count，按升序写入
+    // ShiftLeft 的核心：r[i] = (src[i] << bits) | (src[i-1] >> (64-bits))，0 < i <= count，按降序写入
+    // 0 < bits < 64。读写顺序保证 r 与 src 重叠（r <= src 或 r >= src 分别对应右移、左移）时结果正确
+    struct Kernels
+    {
+        void (*And)(Limb* r, const Limb* a, const Limb* b, size_t n);
+        void (*Or)(Limb* r, const Limb* a, const Limb* b, size_t n);
+        void (*Xor)(Limb* r, const Limb* a, const Limb* b, size_t n);
+        void (*Not)(Limb* r, const Limb* a, size_t n);
+        void (*ShiftRightBits)(Limb* r, const Limb* src, size_t count, unsigned bits);
+        void (*ShiftLeftBits)(Limb* r, const Limb* src, size_t count, unsigned bits);
+    };
+
+    void AndScalar(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i] & b[i];
+        }
+    }
+
+    void OrScalar(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i] | b[i];
+        }
+    }
+
+    void XorScalar(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i] ^ b[i];
+        }
+    }
+
+    void NotScalar(Limb* r, const Limb* a, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = ~a[i];
+        }
+    }
+
+    void ShiftRightBitsScalar(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            r[i] = (src[i] >> bits) | (src[i + 1] << (LIMB_BITS - bits));
+        }
+    }
+
+    void ShiftLeftBitsScalar(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        for (size_t i = count; i > 0; --i)
+        {
+            r[i] = (src[i] << bits) | (src[i - 1] >> (LIMB_BITS - bits));
+        }
+    }
+
+    size_t PopCountScalar(const Limb* a, size_t n)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            count += LimbOps::PopCount(a[i]);
+        }
+        return count;
+    }
+
+#ifdef LIMBOPS_X86_SIMD
+    // ---------------- SSE2：每次2个字 ----------------
+
+    SIMD_TARGET("sse2") void AndSse2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_and_si128(x, y));
+        }
+        AndScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("sse2") void OrSse2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_or_si128(x, y));
+        }
+        OrScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("sse2") void XorSse2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_xor_si128(x, y));
+        }
+        XorScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("sse2") void NotSse2(Limb* r, const Limb* a, size_t n)
+    {
+        const __m128i ones = _mm_set1_epi32(-1);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_xor_si128(x, ones));
+        }
+        NotScalar(r + i, a + i, n - i);
+    }
+
+    SIMD_TARGET("sse2") void ShiftRightBitsSse2(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1));
+            __m128i value = _mm_or_si128(_mm_srl_epi64(lo, right), _mm_sll_epi64(hi, left));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), value);
+        }
+        ShiftRightBitsScalar(r + i, src + i, count - i, bits);
+    }
+
+    SIMD_TARGET("sse2") void ShiftLeftBitsSse2(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = count;
+        for (; i >= 2; i -= 2)
+        {
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i - 1));
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i - 2));
+            __m128i value = _mm_or_si128(_mm_sll_epi64(hi, left), _mm_srl_epi64(lo, right));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i - 1), value);
+        }
+        ShiftLeftBitsScalar(r, src, i, bits);
+    }
+
+    // ---------------- AVX2：每次4个字 ----------------
+
+    SIMD_TARGET("avx2") void AndAvx2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_and_si256(x, y));
+        }
+        AndScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx2") void OrAvx2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_or_si256(x, y));
+        }
+        OrScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx2") void XorAvx2(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_xor_si256(x, y));
+        }
+        XorScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx2") void NotAvx2(Limb* r, const Limb* a, size_t n)
+    {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_xor_si256(x, ones));
+        }
+        NotScalar(r + i, a + i, n - i);
+    }
+
+    SIMD_TARGET("avx2") void ShiftRightBitsAvx2(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 1));
+            __m256i value = _mm256_or_si256(_mm256_srl_epi64(lo, right), _mm256_sll_epi64(hi, left));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), value);
+        }
+        ShiftRightBitsScalar(r + i, src + i, count - i, bits);
+    }
+
+    SIMD_TARGET("avx2") void ShiftLeftBitsAvx2(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = count;
+        for (; i >= 4; i -= 4)
+        {
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - 3));
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - 4));
+            __m256i value = _mm256_or_si256(_mm256_sll_epi64(hi, left), _mm256_srl_epi64(lo, right));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i - 3), value);
+        }
+        ShiftLeftBitsScalar(r, src, i, bits);
+    }
+
+    // ---------------- AVX-512：每次8个字 ----------------
+
+    SIMD_TARGET("avx512f") void AndAvx512(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(r + i, _mm512_and_si512(x, y));
+        }
+        AndScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx512f") void OrAvx512(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(r + i, _mm512_or_si512(x, y));
+        }
+        OrScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx512f") void XorAvx512(Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(r + i, _mm512_xor_si512(x, y));
+        }
+        XorScalar(r + i, a + i, b + i, n - i);
+    }
+
+    SIMD_TARGET("avx512f") void NotAvx512(Limb* r, const Limb* a, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m512i x = _mm512_loadu_si512(a + i);
+            _mm512_storeu_si512(r + i, _mm512_ternarylogic_epi64(x, x, x, 0x55));
+        }
+        NotScalar(r + i, a + i, n - i);
+    }
+
+    SIMD_TARGET("avx512f") void ShiftRightBitsAvx512(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m512i lo = _mm512_loadu_si512(src + i);
+            __m512i hi = _mm512_loadu_si512(src + i + 1);
+            __m512i value = _mm512_or_si512(_mm512_srl_epi64(lo, right), _mm512_sll_epi64(hi, left));
+            _mm512_storeu_si512(r + i, value);
+        }
+        ShiftRightBitsScalar(r + i, src + i, count - i, bits);
+    }
+
+    SIMD_TARGET("avx512f") void ShiftLeftBitsAvx512(Limb* r, const Limb* src, size_t count, unsigned bits)
+    {
+        const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(LIMB_BITS - bits));
+        size_t i = count;
+        for (; i >= 8; i -= 8)
+        {
+            __m512i hi = _mm512_loadu_si512(src + i - 7);
+            __m512i lo = _mm512_loadu_si512(src + i - 8);
+            __m512i value = _mm512_or_si512(_mm512_sll_epi64(hi, left), _mm512_srl_epi64(lo, right));
+            _mm512_storeu_si512(r + i - 7, value);
+        }
+        ShiftLeftBitsScalar(r, src, i, bits);
+    }
+
+    // ---------------- POPCNT：与向量级别无关，单独检测 ----------------
+
+    // 四个累加器交错，避开部分 CPU 上 POPCNT 对目标寄存器的假依赖
+    SIMD_TARGET("popcnt") size_t PopCountHardware(const Limb* a, size_t n)
+    {
+        unsigned long long c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            c0 += _mm_popcnt_u64(a[i]);
+            c1 += _mm_popcnt_u64(a[i + 1]);
+            c2 += _mm_popcnt_u64(a[i + 2]);
+            c3 += _mm_popcnt_u64(a[i + 3]);
+        }
+        for (; i < n; ++i)
+        {
+            c0 += _mm_popcnt_u64(a[i]);
+        }
+        return static_cast<size_t>(c0 + c1 + c2 + c3);
+    }
+#endif
+
+    const Kernels ScalarKernels = { AndScalar, OrScalar, XorScalar, NotScalar, ShiftRightBitsScalar, ShiftLeftBitsScalar };
+#ifdef LIMBOPS_X86_SIMD
+    const Kernels Sse2Kernels = { AndSse2, OrSse2, XorSse2, NotSse2, ShiftRightBitsSse2, ShiftLeftBitsSse2 };
+    const Kernels Avx2Kernels = { AndAvx2, OrAvx2, XorAvx2, NotAvx2, ShiftRightBitsAvx2, ShiftLeftBitsAvx2 };
+    const Kernels Avx512Kernels = { AndAvx512, OrAvx512, XorAvx512, NotAvx512, ShiftRightBitsAvx512, ShiftLeftBitsAvx512 };
+#endif
+
+    LimbOps::SimdLevel DetectSimdLevel()
+    {
+#if defined(LIMBOPS_X86_SIMD) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+        bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+        if (maxLeaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            if (avx && zmmEnabled && (info[1] & (1 << 16)) != 0)
+            {
+                return LimbOps::SimdLevel::Avx512;
+            }
+            if (avx && ymmEnabled && (info[1] & (1 << 5)) != 0)
+            {
+                return LimbOps::SimdLevel::Avx2;
+            }
+        }
+        return LimbOps::SimdLevel::Sse2;
+#elif defined(LIMBOPS_X86_SIMD) && defined(__GNUC__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return LimbOps::SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return LimbOps::SimdLevel::Avx2;
+        }
+        return LimbOps::SimdLevel::Sse2;
+#else
+        return LimbOps::SimdLevel::Scalar;
+#endif
+    }
+
+    const Kernels& KernelsFor(LimbOps::SimdLevel level)
+    {
+        switch (level)
+        {
+#ifdef LIMBOPS_X86_SIMD
+        case LimbOps::SimdLevel::Avx512:
+            return Avx512Kernels;
+        case LimbOps::SimdLevel::Avx2:
+            return Avx2Kernels;
+        case LimbOps::SimdLevel::Sse2:
+            return Sse2Kernels;
+#endif
+        default:
+            return ScalarKernels;
+        }
+    }
+
+    bool DetectPopcnt()
+    {
+#if defined(LIMBOPS_X86_SIMD) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 23)) != 0;
+#elif defined(LIMBOPS_X86_SIMD) && defined(__GNUC__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") != 0;
+#else
+        return false;
+#endif
+    }
+
+    // 程序启动时（静态初始化阶段）检测一次
+    const LimbOps::SimdLevel SupportedLevel = DetectSimdLevel();
+    LimbOps::SimdLevel ActiveLevel = SupportedLevel;
+    const Kernels* Active = &KernelsFor(SupportedLevel);
+    // 初始化之前为 false，其他翻译单元的静态对象先调用时使用标量实现
+    const bool HasPopcnt = DetectPopcnt();
+
+    // 静态初始化顺序不确定，其他翻译单元的静态对象可能先调用到这里
+    const Kernels& ActiveKernels()
+    {
+        return Active != nullptr ? *Active : ScalarKernels;
+    }
+}
+
+LimbOps::SimdLevel LimbOps::GetSimdLevel()
+{
+    return ActiveLevel;
+}
+
+void LimbOps::SetSimdLevel(SimdLevel level)
+{
+    ActiveLevel = std::min(level, SupportedLevel);
+    Active = &KernelsFor(ActiveLevel);
+}
+
+void LimbOps::And(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    if (n < SIMD_MIN_LIMBS)
+    {
+        AndScalar(r, a, b, n);
+        return;
+    }
+    ActiveKernels().And(r, a, b, n);
+}
+
+void LimbOps::Or(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    if (n < SIMD_MIN_LIMBS)
+    {
+        OrScalar(r, a, b, n);
+        return;
+    }
+    ActiveKernels().Or(r, a, b, n);
+}
+
+void LimbOps::Xor(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    if (n < SIMD_MIN_LIMBS)
+    {
+        XorScalar(r, a, b, n);
+        return;
+    }
+    ActiveKernels().Xor(r, a, b, n);
+}
+
+void LimbOps::Not(Limb* r, const Limb* a, size_t n)
+{
+    if (n < SIMD_MIN_LIMBS)
+    {
+        NotScalar(r, a, n);
+        return;
+    }
+    ActiveKernels().Not(r, a, n);
+}
+
+void LimbOps::ShiftLeft(Limb* r, const Limb* a, size_t n, size_t shift)
+{
+    size_t limbShift = shift / LIMB_BITS;
+    unsigned bitShift = static_cast<unsigned>(shift % LIMB_BITS);
+
+    if (limbShift >= n)
+    {
+        std::fill_n(r, n, 0);
+        return;
+    }
+
+    // 从高位往低位处理，保证 r 与 a 相同时不会覆盖还未读取的字
+    if (bitShift == 0)
+    {
+        std::copy_backward(a, a + n - limbShift, r + n);
+    }
+    else
+    {
+        size_t count = n - 1 - limbShift;
+        if (count < SIMD_MIN_LIMBS)
+        {
+            ShiftLeftBitsScalar(r + limbShift, a, count, bitShift);
+        }
+        else
+        {
+            ActiveKernels().ShiftLeftBits(r + limbShift, a, count, bitShift);
+        }
+        r[limbShift] = a[0] << bitShift;
+    }
+    std::fill_n(r, limbShift, 0);
+}
+
+void LimbOps::ShiftRight(Limb* r, const Limb* a, size_t n, size_t shift)
+{
+    size_t limbShift = shift / LIMB_BITS;
+    unsigned bitShift = static_cast<unsigned>(shift % LIMB_BITS);
+
+    if (limbShift >= n)
+    {
+        std::fill_n(r, n, 0);
+        return;
+    }
+
+    // 从低位往高位处理，保证 r 与 a 相同时不会覆盖还未读取的字
+    size_t keep = n - limbShift;
+    if (bitShift == 0)
+    {
+        std::copy(a + limbShift, a + n, r);
+    }
+    else
+    {
+        if (keep - 1 < SIMD_MIN_LIMBS)
+        {
+            ShiftRightBitsScalar(r, a + limbShift, keep - 1, bitShift);
+        }
+        else
+        {
+            ActiveKernels().ShiftRightBits(r, a + limbShift, keep - 1, bitShift);
+        }
+        r[keep - 1] = a[n - 1] >> bitShift;
+    }
+    std::fill_n(r + keep, limbShift, 0);
+}
+
+size_t LimbOps::PopCount(const Limb* a, size_t n)
+{
+#ifdef LIMBOPS_X86_SIMD
+    // 降到 Scalar 级别时同样不用 POPCNT，方便对比
+    if (HasPopcnt && ActiveLevel != SimdLevel::Scalar)
+    {
+        return PopCountHardware(a, n);
+    }
+#endif
+    return PopCountScalar(a, n);
+}
+
+size_t LimbOps::FindNextSet(const Limb* a, size_t n, size_t from)
+{
+    size_t i = from / LIMB_BITS;
+    if (i >= n)
+    {
+        return n * LIMB_BITS;
+    }
+
+    // 第一个字先去掉 from 以下的位，之后逐字跳过0字
+    Limb word = a[i] & (~Limb(0) << (from % LIMB_BITS));
+    while (word == 0)
+    {
+        if (++i == n)
+        {
+            return n * LIMB_BITS;
+        }
+        word = a[i];
+    }
+    return i * LIMB_BITS + CountTrailingZeros(word);
+}
+
+size_t LimbOps::BitLength(const Limb* a, size_t n)
+{
+    n = Normalized(a, n);
+    return n == 0 ? 0 : n * LIMB_BITS - CountLeadingZeros(a[n - 1]);
+}
+
+Limb LimbOps::ExtractBits(const Limb* a, size_t pos, size_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    size_t i = pos / LIMB_BITS;
+    unsigned offset = static_cast<unsigned>(pos % LIMB_BITS);
+    Limb value = a[i] >> offset;
+    // 只有跨字时才读下一个字，避免越过数组末尾
+    if (offset != 0 && offset + count > LIMB_BITS)
+    {
+        value |= a[i + 1] << (LIMB_BITS - offset);
+    }
+    return count == LIMB_BITS ? value : value & ((Limb(1) << count) - 1);
+}
+
+void LimbOps::InsertBits(Limb* a, size_t pos, size_t count, Limb value)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    Limb mask = count == LIMB_BITS ? ~Limb(0) : ((Limb(1) << count) - 1);
+    value &= mask;
+    size_t i = pos / LIMB_BITS;
+    unsigned offset = static_cast<unsigned>(pos % LIMB_BITS);
+    a[i] = (a[i] & ~(mask << offset)) | (value << offset);
+    if (offset != 0 && offset + count > LIMB_BITS)
+    {
+        unsigned shift = LIMB_BITS - offset;
+        a[i + 1] = (a[i + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+}
@@ -0,0 +1,252 @@
+#include "LimbOps.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// 除数不少于该字数（且商也不少于该字数）时使用 Burnikel-Ziegler 递归除法，可在编译时覆盖
+#ifndef DIV_BZ_THRESHOLD
+#define DIV_BZ_THRESHOLD 120
+#endif
+
+namespace
+{
+    // Knuth 算法 D。u 共 un+1 个字（最高处多一个字），v 为 vn 个已规格化（最高位为1）的字，vn >= 2。
+    // 商写入 q[0..un-vn+1)，余数留在 u[0..vn)
+    void DivKnuthNormalized(Limb* q, Limb* u, size_t un, const Limb* v, size_t vn)
+    {
+        Limb v1 = v[vn - 1];
+        Limb v2 = v[vn - 2];
+
+        for (size_t j = un - vn + 1; j-- > 0;)
+        {
+            Limb ujn = u[j + vn];
+            Limb ujn1 = u[j + vn - 1];
+            Limb ujn2 = u[j + vn - 2];
+
+            // 用最高两个字估计商 qhat，再用次高位修正，最多偏大1
+            Limb qhat, rhat;
+            bool rhatOverflow = false;
+            if (ujn >= v1)
+            {
+                qhat = ~Limb(0);
+                rhat = ujn1 + v1;
+                rhatOverflow = rhat < ujn1;
+            }
+            else
+            {
+                qhat = LimbOps::DivHiLo(ujn, ujn1, v1, rhat);
+            }
+
+            while (!rhatOverflow)
+            {
+                Limb productHi;
+                Limb productLo = LimbOps::MulHiLo(qhat, v2, productHi);
+                if (productHi < rhat || (productHi == rhat && productLo <= ujn2))
+                {
+                    break;
+                }
+                --qhat;
+                rhat += v1;
+                rhatOverflow = rhat < v1;
+            }
+
+            // u[j..j+vn] -= qhat * v，减成负数时说明 qhat 大了1，加回一次 v
+            Limb borrow = LimbOps::SubMul1(u + j, v, vn, qhat);
+            Limb top = u[j + vn];
+            u[j + vn] = top - borrow;
+            if (top < borrow)
+            {
+                --qhat;
+                u[j + vn] += LimbOps::Add(u + j, u + j, v, vn);
+            }
+            q[j] = qhat;
+        }
+    }
+
+    // 任意 b（vn >= 2）的 Knuth 除法：先把 b 左移到最高位为1，a 左移同样的位数
+    void DivKnuth(Limb* q, Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        unsigned shift = LimbOps::CountLeadingZeros(b[bn - 1]);
+
+        std::vector<Limb> u(an + 1), v(bn);
+        std::copy(a, a + an, u.begin());
+        u[an] = 0;
+        LimbOps::ShiftLeft(u.data(), u.data(), an + 1, shift);
+        LimbOps::ShiftLeft(v.data(), b, bn, shift);
+
+        DivKnuthNormalized(q, u.data(), an, v.data(), bn);
+        LimbOps::ShiftRight(r, u.data(), bn, shift);
+    }
+
+    void Div3n2n(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t h);
+
+    // a 为 2n 个字，b 为 n 个已规格化的字，要求 a < B^n * b。商与余数各 n 个字
+    void Div2n1n(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t n)
+    {
+        if (n % 2 != 0 || n < DIV_BZ_THRESHOLD)
+        {
+            std::vector<Limb> u(2 * n + 1), quotient(n + 1);
+            std::copy(a, a + 2 * n, u.begin());
+            u[2 * n] = 0;
+            DivKnuthNormalized(quotient.data(), u.data(), 2 * n, b, n);
+            std::copy(quotient.begin(), quotient.begin() + n, q);
+            std::copy(u.begin(), u.begin() + n, r);
+            return;
+        }
+
+        // a = [a1 a2 a3 a4]，先用 [a1 a2 a3] 求商的高半部分，再用 [余数 a4] 求低半部分
+        size_t h = n / 2;
+        std::vector<Limb> next(3 * h);
+        Div3n2n(q + h, next.data() + h, a + h, b, h);
+        std::copy(a, a + h, next.begin());
+        Div3n2n(q, r, next.data(), b, h);
+    }
+
+    // a 为 3h 个字，b 为 2h 个已规格化的字，要求 a 的高 2h 个字 < b。商 h 个字，余数 2h 个字
+    void Div3n2n(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t h)
+    {
+        const Limb* a1 = a + 2 * h;
+        const Limb* a2 = a + h;
+        const Limb* b1 = b + h;
+
+        // work = [c a3]，c 最多 h+1 个字
+        std::vector<Limb> work(2 * h + 1);
+        if (LimbOps::Compare(a1, b1, h) < 0)
+        {
+            // (q, c) = [a1 a2] / b1
+            Div2n1n(q, work.data() + h, a2, b1, h);
+            work[2 * h] = 0;
+        }
+        else
+        {
+            // 此时 a1 == b1：q = B^h - 1，c = [a1 a2] - q*b1 = a2 + b1
+            std::fill(q, q + h, ~Limb(0));
+            work[2 * h] = LimbOps::Add(work.data() + h, a2, b1, h);
+        }
+        std::copy(a, a + h, work.begin());
+
+        // 余数 = [c a3] - q*b2，为负时商减1、余数加 b，最多两次
+        std::vector<Limb> d(2 * h);
+        LimbOps::Mul(d.data(), q, h, b, h);
+        Limb borrow = LimbOps::Sub(work.data(), work.data(), d.data(), 2 * h);
+        work[2 * h] -= borrow;
+        while (work[2 * h] >> (LIMB_BITS - 1))
+        {
+            for (size_t i = 0; i < h && q[i]-- == 0; ++i)
+            {
+            }
+            work[2 * h] += LimbOps::Add(work.data(), work.data(), b, 2 * h);
+        }
+        std::copy(work.begin(), work.begin() + 2 * h, r);
+    }
+
+    // Burnikel-Ziegler 递归除法：把 b 补齐为 n = j * 2^k 个字（j < 阈值）并规格化，
+    // a 按 n 个字分块后自高向低逐块做 2n/n 除法
+    void DivBurnikelZiegler(Limb* q, Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        size_t blocks = 1;
+        while ((bn + blocks - 1) / blocks >= DIV_BZ_THRESHOLD)
+        {
+            blocks *= 2;
+        }
+        size_t n = (bn + blocks - 1) / blocks * blocks;
+        size_t pad = n - bn;
+        unsigned shift = LimbOps::CountLeadingZeros(b[bn - 1]);
+
+        // b、a 同时乘以 B^pad * 2^shift，商不变
+        std::vector<Limb> divisor(n, 0);
+        LimbOps::ShiftLeft(divisor.data() + pad, b, bn, shift);
+
+        size_t t = (an + pad + 1 + n - 1) / n;
+        std::vector<Limb> dividend(t * n, 0);
+        std::copy(a, a + an, dividend.begin() + pad);
+        LimbOps::ShiftLeft(dividend.data(), dividend.data(), t * n, shift);
+        if (LimbOps::Compare(dividend.data() + (t - 1) * n, divisor.data(), n) >= 0)
+        {
+            dividend.resize((t + 1) * n, 0);
+            ++t;
+        }
+
+        std::vector<Limb> quotient((t - 1) * n), z(2 * n);
+        std::vector<Limb> remainder(dividend.begin() + (t - 1) * n, dividend.end());
+        for (size_t i = t - 1; i-- > 0;)
+        {
+            std::copy(dividend.begin() + i * n, dividend.begin() + (i + 1) * n, z.begin());
+            std::copy(remainder.begin(), remainder.end(), z.begin() + n);
+            Div2n1n(quotient.data() + i * n, remainder.data(), z.data(), divisor.data(), n);
+        }
+
+        size_t qn = an - bn + 1;
+        std::fill(q, q + qn, 0);
+        std::copy(quotient.begin(), quotient.begin() + std::min(qn, quotient.size()), q);
+
+        LimbOps::ShiftRight(remainder.data(), remainder.data(), n, shift);
+        std::copy(remainder.begin() + pad, remainder.end(), r);
+    }
+}
+
+void LimbOps::DivRem(Limb* q, Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+{
+    if (bn == 1)
+    {
+        INSTRUMENT_COUNT(Instrument::Op::DivSingleLimb, an);
+        r[0] = DivRem1(q, a, an, b[0]);
+    }
+    else if (bn < DIV_BZ_THRESHOLD || an - bn < DIV_BZ_THRESHOLD)
+    {
+        INSTRUMENT_COUNT(Instrument::Op::DivKnuth, an);
+        DivKnuth(q, r, a, an, b, bn);
+    }
+    else
+    {
+        INSTRUMENT_COUNT(Instrument::Op::DivBurnikelZiegler, an);
+        DivBurnikelZiegler(q, r, a, an, b, bn);
+    }
+}
+
+void LimbOps::SignedDivRem(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t BitSize)
+{
+    size_t n = LimbCount(BitSize);
+    TempLimbs dividend(n), divisor(n);
+    bool dividendNegative = Magnitude(dividend.data(), a, BitSize);
+    bool divisorNegative = Magnitude(divisor.data(), b, BitSize);
+
+    size_t an = Normalized(dividend.data(), n);
+    size_t bn = Normalized(divisor.data(), n);
+    if (bn == 0)
+    {
+        throw std::domain_error("Division by zero");
+    }
+
+    // 商向0取整，余数与被除数同号
+    TempLimbs quotient(n), remainder(n);
+    std::fill(quotient.data(), quotient.data() + n, 0);
+    std::fill(remainder.data(), remainder.data() + n, 0);
+    if (an < bn)
+    {
+        std::copy(dividend.data(), dividend.data() + n, remainder.data());
+    }
+    else
+    {
+        DivRem(quotient.data(), remainder.data(), dividend.data(), an, divisor.data(), bn);
+    }
+
+    if (q != nullptr)
+    {
+        if (dividendNegative != divisorNegative)
+        {
+            Negate(quotient.data(), quotient.data(), n);
+        }
+        std::copy(quotient.data(), quotient.data() + n, q);
+        q[n - 1] &= TopMask(BitSize);
+    }
+    if (r != nullptr)
+    {
+        if (dividendNegative)
+        {
+            Negate(remainder.data(), remainder.data(), n);
+        }
+        std::copy(remainder.data(), remainder.data() + n, r);
+        r[n - 1] &= TopMask(BitSize);
+    }
+}
@@ -0,0 +1,486 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+// 惰性求值的表达式模板。用 Expr::Lazy(x) 包装第一个操作数后，+、-、*、<<、>> 只构造表达式树，
+// 赋值给 BigInt（或 +=、-=）时才一次性算到目标的存储里，中间不产生 BigInt 临时对象：
+//
+//     acc += Expr::Lazy(a) * b;                 // 乘加融合，直接累加到 acc
+//     r = Expr::Lazy(a) + (Expr::Lazy(b) << 7); // 加移位融合
+//     r = Expr::Lazy(a) + Expr::Lazy(b) * c - d;
+//
+// 结果与逐个调用 BigInt 运算符相同（按 BitSize 位回绕，>> 为逻辑移位）。表达式只保存操作数的引用，
+// 不要用 auto 保存表达式对象留到语句之后再求值
+namespace Expr
+{
+	// 字数不超过该值时，乘积直接以截断的 basecase 累加到目标上，否则先用 MulLow 算出乘积
+	const size_t FusedBasecaseLimbs = 32;
+
+	template <class Derived>
+	struct Expression
+	{
+		const Derived& Self() const { return static_cast<const Derived&>(*this); }
+	};
+
+	// 叶子：引用一个 BigInt
+	struct Ref :Expression<Ref>
+	{
+		static const bool IsLeaf = true;
+		static const bool LeftChainInPlace = true;
+
+		const BigInt& Value;
+
+		explicit Ref(const BigInt& value) :Value(value) {}
+
+		size_t BitSize() const { return Value.GetBitSize(); }
+		bool CheckBitSize(size_t bits) const { return Value.GetBitSize() == bits; }
+		size_t CountReferences(const Number* target) const { return &Value == target ? 1 : 0; }
+		size_t LowestInvalidBit() const { return Value.LowestInvalidBit(); }
+		const Number* Leftmost() const { return &Value; }
+		const Limb* Data() const { return Value.GetData(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			if (Value.GetData() != out)
+			{
+				std::copy(Value.GetData(), Value.GetData() + n, out);
+			}
+		}
+
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			if (subtract)
+			{
+				LimbOps::Sub(out, out, Value.GetData(), n);
+			}
+			else
+			{
+				LimbOps::Add(out, out, Value.GetData(), n);
+			}
+		}
+	};
+
+	// 叶子直接返回其数据，其他表达式先算到 storage 里
+	template <class E>
+	const Limb* Materialize(const E& e, LimbOps::TempLimbs& storage, size_t n)
+	{
+		e.EvaluateInto(storage.data(), n);
+		return storage.data();
+	}
+
+	inline const Limb* Materialize(const Ref& e, LimbOps::TempLimbs&, size_t)
+	{
+		return e.Data();
+	}
+
+	// 没有融合核的表达式：先算到临时缓冲区再加减
+	template <class E>
+	void AccumulateViaTemp(const E& e, Limb* out, size_t n, bool subtract)
+	{
+		LimbOps::TempLimbs temp(n);
+		e.EvaluateInto(temp.data(), n);
+		if (subtract)
+		{
+			LimbOps::Sub(out, out, temp.data(), n);
+		}
+		else
+		{
+			LimbOps::Add(out, out, temp.data(), n);
+		}
+	}
+
+	template <class L, class R>
+	struct Sum :Expression<Sum<L, R>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = L::LeftChainInPlace;
+
+		L Left;
+		R Right;
+
+		Sum(const L& left, const R& right) :Left(left), Right(right) {}
+
+		size_t BitSize() const { return Left.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Left.CheckBitSize(bits) && Right.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Left.CountReferences(target) + Right.CountReferences(target); }
+		size_t LowestInvalidBit() const { return std::min(Left.LowestInvalidBit(), Right.LowestInvalidBit()); }
+		const Number* Leftmost() const { return Left.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			Left.EvaluateInto(out, n);
+			Right.AccumulateInto(out, n, false);
+		}
+
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			Left.AccumulateInto(out, n, subtract);
+			Right.AccumulateInto(out, n, subtract);
+		}
+	};
+
+	template <class L, class R>
+	struct Difference :Expression<Difference<L, R>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = L::LeftChainInPlace;
+
+		L Left;
+		R Right;
+
+		Difference(const L& left, const R& right) :Left(left), Right(right) {}
+
+		size_t BitSize() const { return Left.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Left.CheckBitSize(bits) && Right.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Left.CountReferences(target) + Right.CountReferences(target); }
+		size_t LowestInvalidBit() const { return std::min(Left.LowestInvalidBit(), Right.LowestInvalidBit()); }
+		const Number* Leftmost() const { return Left.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			Left.EvaluateInto(out, n);
+			Right.AccumulateInto(out, n, true);
+		}
+
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			Left.AccumulateInto(out, n, subtract);
+			Right.AccumulateInto(out, n, !subtract);
+		}
+	};
+
+	// 补码乘积的低位与符号无关，所有乘法都按 n 个字截断
+	template <class L, class R>
+	struct Product :Expression<Product<L, R>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = false;
+
+		L Left;
+		R Right;
+
+		Product(const L& left, const R& right) :Left(left), Right(right) {}
+
+		size_t BitSize() const { return Left.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Left.CheckBitSize(bits) && Right.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Left.CountReferences(target) + Right.CountReferences(target); }
+		size_t LowestInvalidBit() const { return std::min(Left.LowestInvalidBit(), Right.LowestInvalidBit()); }
+		const Number* Leftmost() const { return Left.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			LimbOps::TempLimbs leftStorage(L::IsLeaf ? 0 : n), rightStorage(R::IsLeaf ? 0 : n);
+			const Limb* a = Materialize(Left, leftStorage, n);
+			const Limb* b = Materialize(Right, rightStorage, n);
+			if (n <= FusedBasecaseLimbs)
+			{
+				std::fill(out, out + n, 0);
+				MulAccumulate(out, a, b, n, false);
+			}
+			else
+			{
+				LimbOps::MulLow(out, a, b, n);
+			}
+		}
+
+		// 乘加/乘减融合：out ± a*b
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			LimbOps::TempLimbs leftStorage(L::IsLeaf ? 0 : n), rightStorage(R::IsLeaf ? 0 : n);
+			const Limb* a = Materialize(Left, leftStorage, n);
+			const Limb* b = Materialize(Right, rightStorage, n);
+			if (n <= FusedBasecaseLimbs)
+			{
+				MulAccumulate(out, a, b, n, subtract);
+				return;
+			}
+
+			LimbOps::TempLimbs product(n);
+			LimbOps::MulLow(product.data(), a, b, n);
+			if (subtract)
+			{
+				LimbOps::Sub(out, out, product.data(), n);
+			}
+			else
+			{
+				LimbOps::Add(out, out, product.data(), n);
+			}
+		}
+
+	private:
+		static void MulAccumulate(Limb* out, const Limb* a, const Limb* b, size_t n, bool subtract)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (subtract)
+				{
+					LimbOps::SubMul1(out + i, b, n - i, a[i]);
+				}
+				else
+				{
+					LimbOps::AddMul1(out + i, b, n - i, a[i]);
+				}
+			}
+		}
+	};
+
+	// 乘以一个有符号的单字整数
+	template <class E>
+	struct Scaled :Expression<Scaled<E>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = E::LeftChainInPlace;
+
+		E Inner;
+		std::int64_t Factor;
+
+		Scaled(const E& inner, std::int64_t factor) :Inner(inner), Factor(factor) {}
+
+		size_t BitSize() const { return Inner.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Inner.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Inner.CountReferences(target); }
+		size_t LowestInvalidBit() const { return Inner.LowestInvalidBit(); }
+		const Number* Leftmost() const { return Inner.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			Inner.EvaluateInto(out, n);
+			LimbOps::Mul1(out, out, n, Magnitude());
+			if (Factor < 0)
+			{
+				LimbOps::Negate(out, out, n);
+			}
+		}
+
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			LimbOps::TempLimbs storage(E::IsLeaf ? 0 : n);
+			const Limb* a = Materialize(Inner, storage, n);
+			if (subtract != (Factor < 0))
+			{
+				LimbOps::SubMul1(out, a, n, Magnitude());
+			}
+			else
+			{
+				LimbOps::AddMul1(out, a, n, Magnitude());
+			}
+		}
+
+	private:
+		Limb Magnitude() const
+		{
+			return Factor < 0 ? Limb(0) - static_cast<Limb>(Factor) : static_cast<Limb>(Factor);
+		}
+	};
+
+	template <class E>
+	struct ShiftedLeft :Expression<ShiftedLeft<E>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = E::LeftChainInPlace;
+
+		E Inner;
+		size_t Shift;
+
+		ShiftedLeft(const E& inner, size_t shift) :Inner(inner), Shift(shift) {}
+
+		size_t BitSize() const { return Inner.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Inner.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Inner.CountReferences(target); }
+		size_t LowestInvalidBit() const
+		{
+			size_t low = Inner.LowestInvalidBit();
+			return low >= BitSize() || Shift >= BitSize() - low ? BitSize() : low + Shift;
+		}
+		const Number* Leftmost() const { return Inner.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			Inner.EvaluateInto(out, n);
+			LimbOps::ShiftLeft(out, out, n, Shift);
+		}
+
+		// 加移位融合：移位后的字在加法循环中现算，不需要临时缓冲区
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			LimbOps::TempLimbs storage(E::IsLeaf ? 0 : n);
+			const Limb* a = Materialize(Inner, storage, n);
+
+			size_t limbShift = Shift / LIMB_BITS;
+			size_t bitShift = Shift % LIMB_BITS;
+			unsigned char carry = 0;
+			for (size_t i = limbShift; i < n; ++i)
+			{
+				size_t j = i - limbShift;
+				Limb word = a[j] << bitShift;
+				if (bitShift != 0 && j > 0)
+				{
+					word |= a[j - 1] >> (LIMB_BITS - bitShift);
+				}
+				out[i] = subtract ? LimbOps::SubBorrow(out[i], word, carry) : LimbOps::AddCarry(out[i], word, carry);
+			}
+		}
+	};
+
+	// 逻辑右移：先按 BitSize 截掉高位再移位，与 Number::operator>> 一致
+	template <class E>
+	struct ShiftedRight :Expression<ShiftedRight<E>>
+	{
+		static const bool IsLeaf = false;
+		static const bool LeftChainInPlace = E::LeftChainInPlace;
+
+		E Inner;
+		size_t Shift;
+
+		ShiftedRight(const E& inner, size_t shift) :Inner(inner), Shift(shift) {}
+
+		size_t BitSize() const { return Inner.BitSize(); }
+		bool CheckBitSize(size_t bits) const { return Inner.CheckBitSize(bits); }
+		size_t CountReferences(const Number* target) const { return Inner.CountReferences(target); }
+		size_t LowestInvalidBit() const
+		{
+			size_t low = Inner.LowestInvalidBit();
+			return low >= BitSize() ? low : (low > Shift ? low - Shift : 0);
+		}
+		const Number* Leftmost() const { return Inner.Leftmost(); }
+
+		void EvaluateInto(Limb* out, size_t n) const
+		{
+			Inner.EvaluateInto(out, n);
+			out[n - 1] &= LimbOps::TopMask(BitSize());
+			LimbOps::ShiftRight(out, out, n, Shift);
+		}
+
+		void AccumulateInto(Limb* out, size_t n, bool subtract) const
+		{
+			AccumulateViaTemp(*this, out, n, subtract);
+		}
+	};
+
+	inline Ref Lazy(const BigInt& value)
+	{
+		return Ref(value);
+	}
+
+	template <class L, class R>
+	Sum<L, R> operator+(const Expression<L>& left, const Expression<R>& right) { return Sum<L, R>(left.Self(), right.Self()); }
+	template <class L>
+	Sum<L, Ref> operator+(const Expression<L>& left, const BigInt& right) { return Sum<L, Ref>(left.Self(), Ref(right)); }
+	template <class R>
+	Sum<Ref, R> operator+(const BigInt& left, const Expression<R>& right) { return Sum<Ref, R>(Ref(left), right.Self()); }
+
+	template <class L, class R>
+	Difference<L, R> operator-(const Expression<L>& left, const Expression<R>& right) { return Difference<L, R>(left.Self(), right.Self()); }
+	template <class L>
+	Difference<L, Ref> operator-(const Expression<L>& left, const BigInt& right) { return Difference<L, Ref>(left.Self(), Ref(right)); }
+	template <class R>
+	Difference<Ref, R> operator-(const BigInt& left, const Expression<R>& right) { return Difference<Ref, R>(Ref(left), right.Self()); }
+
+	template <class L, class R>
+	Product<L, R> operator*(const Expression<L>& left, const Expression<R>& right) { return Product<L, R>(left.Self(), right.Self()); }
+	template <class L>
+	Product<L, Ref> operator*(const Expression<L>& left, const BigInt& right) { return Product<L, Ref>(left.Self(), Ref(right)); }
+	template <class R>
+	Product<Ref, R> operator*(const BigInt& left, const Expression<R>& right) { return Product<Ref, R>(Ref(left), right.Self()); }
+
+	template <class E>
+	Scaled<E> operator*(const Expression<E>& inner, std::int64_t factor) { return Scaled<E>(inner.Self(), factor); }
+	template <class E>
+	Scaled<E> operator*(std::int64_t factor, const Expression<E>& inner) { return Scaled<E>(inner.Self(), factor); }
+
+	template <class E>
+	ShiftedLeft<E> operator<<(const Expression<E>& inner, size_t shift) { return ShiftedLeft<E>(inner.Self(), shift); }
+	template <class E>
+	ShiftedRight<E> operator>>(const Expression<E>& inner, size_t shift) { return ShiftedRight<E>(inner.Self(), shift); }
+}
+
+template <class E>
+BigInt::BigInt(const Expr::Expression<E>& expression) :Number(expression.Self().BitSize())
+{
+	this->NumberType = Type::Integer;
+	const E& e = expression.Self();
+	if (!e.CheckBitSize(BitSize))
+	{
+		throw std::invalid_argument("Bit sizes do not match");
+	}
+	e.EvaluateInto(Data, GetLimbCount());
+	ClearUnusedBits();
+	// 结果的无效位按加减乘的规则，从各操作数最低的无效位开始
+	MarkValid();
+	MarkInvalidFrom(e.LowestInvalidBit());
+}
+
+template <class E>
+BigInt& BigInt::operator=(const Expr::Expression<E>& expression)
+{
+	const E& e = expression.Self();
+	if (e.BitSize() != BitSize || !e.CheckBitSize(BitSize))
+	{
+		throw std::invalid_argument("Bit sizes do not match");
+	}
+
+	// 目标只作为最左边的操作数出现且沿加减/移位链先被读取时，可以直接在原地求值；否则先算到新对象里
+	size_t references = e.CountReferences(this);
+	if (references == 0 || (references == 1 && E::LeftChainInPlace && e.Leftmost() == this))
+	{
+		size_t unknown = e.LowestInvalidBit();
+		e.EvaluateInto(Data, GetLimbCount());
+		ClearUnusedBits();
+		MarkValid();
+		MarkInvalidFrom(unknown);
+	}
+	else
+	{
+		*this = BigInt(expression);
+	}
+	return *this;
+}
+
+template <class E>
+BigInt& BigInt::operator+=(const Expr::Expression<E>& expression)
+{
+	const E& e = expression.Self();
+	if (!e.CheckBitSize(BitSize))
+	{
+		throw std::invalid_argument("Bit sizes do not match");
+	}
+
+	size_t unknown = std::min(LowestInvalidBit(), e.LowestInvalidBit());
+	if (e.CountReferences(this) == 0)
+	{
+		e.AccumulateInto(Data, GetLimbCount(), false);
+	}
+	else
+	{
+		Expr::AccumulateViaTemp(e, Data, GetLimbCount(), false);
+	}
+	ClearUnusedBits();
+	MarkInvalidFrom(unknown);
+	return *this;
+}
+
+template <class E>
+BigInt& BigInt::operator-=(const Expr::Expression<E>& expression)
+{
+	const E& e = expression.Self();
+	if (!e.CheckBitSize(BitSize))
+	{
+		throw std::invalid_argument("Bit sizes do not match");
+	}
+
+	size_t unknown = std::min(LowestInvalidBit(), e.LowestInvalidBit());
+	if (e.CountReferences(this) == 0)
+	{
+		e.AccumulateInto(Data, GetLimbCount(), true);
+	}
+	else
+	{
+		Expr::AccumulateViaTemp(e, Data, GetLimbCount(), true);
+	}
+	ClearUnusedBits();
+	MarkInvalidFrom(unknown);
+	return *this;
+}
@@ -0,0 +1,380 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// 编译期确定位宽的整数：数据放在对象内（栈上），没有虚函数，循环次数为常量可以完全展开。
+// 与 BigInt 一样使用补码表示，运算结果按 Bits 位回绕；不同位宽的 FixedInt 之间没有转换，混用会编译失败。
+// 加减乘、位运算、移位和比较都是 constexpr；除法和字符串转换调用 LimbOps，只能在运行时使用
+
+namespace FixedIntDetail
+{
+	// 带进位加法（constexpr 版本）
+	constexpr Limb AddCarry(Limb a, Limb b, Limb& carry)
+	{
+		Limb s = a + b;
+		Limb c1 = s < a;
+		Limb r = s + carry;
+		Limb c2 = r < s;
+		carry = c1 | c2;
+		return r;
+	}
+
+	// 带借位减法（constexpr 版本）
+	constexpr Limb SubBorrow(Limb a, Limb b, Limb& borrow)
+	{
+		Limb d = a - b;
+		Limb b1 = a < b;
+		Limb r = d - borrow;
+		Limb b2 = d < borrow;
+		borrow = b1 | b2;
+		return r;
+	}
+
+	// 64x64 -> 128 位乘法（constexpr 版本）
+	constexpr Limb MulHiLo(Limb a, Limb b, Limb& hi)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+		hi = static_cast<Limb>(p >> 64);
+		return static_cast<Limb>(p);
+#else
+#if defined(__cpp_lib_is_constant_evaluated)
+		if (!std::is_constant_evaluated())
+		{
+			return LimbOps::MulHiLo(a, b, hi);
+		}
+#endif
+		Limb al = a & 0xFFFFFFFF, ah = a >> 32;
+		Limb bl = b & 0xFFFFFFFF, bh = b >> 32;
+		Limb ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+		Limb mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+		hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+		return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+	}
+}
+
+template <size_t Bits>
+class FixedInt
+{
+	static_assert(Bits > 0, "FixedInt needs at least one bit");
+
+public:
+	static constexpr size_t BitSize = Bits;
+	static constexpr size_t LimbCount = (Bits + LIMB_BITS - 1) / LIMB_BITS;
+
+	constexpr FixedInt() :Data{} {}
+
+	// 所有机器整数：有符号数按补码符号扩展，无符号数补0，再按 Bits 位回绕。
+	// 整数类型精确匹配，所以字面量0不会与 const char* 构造函数产生歧义
+	template <class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+	constexpr FixedInt(T value) :Data{}
+	{
+		bool negative = std::is_signed<T>::value && static_cast<std::int64_t>(value) < 0;
+		Data[0] = static_cast<Limb>(value);
+		for (size_t i = 1; i < LimbCount; ++i)
+		{
+			Data[i] = negative ? ~Limb(0) : 0;
+		}
+		ClearUnusedBits();
+	}
+
+	// 与 BigInt(const char*, size_t, int) 相同的格式
+	explicit FixedInt(const char* num, int radix = 10) :Data{}
+	{
+		bool isNegative = num[0] == '-';
+		const char* digits = num[0] == '-' || num[0] == '+' ? num + 1 : num;
+		if (digits != num && *digits == '\0')
+		{
+			throw std::invalid_argument("No digits to parse");
+		}
+		LimbOps::FromString(Data, LimbCount, digits, std::strlen(digits), radix);
+		ClearUnusedBits();
+		if (isNegative)
+		{
+			*this = -*this;
+		}
+	}
+
+	// BigInt 的位宽只有运行时才知道，不一致时抛出 std::invalid_argument
+	explicit FixedInt(const BigInt& value) :Data{}
+	{
+		if (value.GetBitSize() != Bits)
+		{
+			throw std::invalid_argument("Bit sizes do not match");
+		}
+		const Limb* source = value.GetData();
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] = source[i];
+		}
+	}
+
+	BigInt ToBigInt() const
+	{
+		return BigInt(Data, Bits);
+	}
+
+	std::string ToString() const
+	{
+		FixedInt magnitude = IsNegative() ? -*this : *this;
+
+		std::string result;
+		if (IsNegative())
+		{
+			result.push_back('-');
+		}
+		LimbOps::ToDecimal(result, magnitude.Data, LimbCount);
+		return result;
+	}
+
+	constexpr const Limb* GetData() const { return Data; }
+	constexpr bool IsNegative() const { return GetBit(Bits - 1) == 1; }
+
+	constexpr int GetBit(size_t BitIndex) const
+	{
+		return static_cast<int>((Data[BitIndex / LIMB_BITS] >> (BitIndex % LIMB_BITS)) & 1);
+	}
+
+	constexpr void SetBit(size_t BitIndex)
+	{
+		Data[BitIndex / LIMB_BITS] |= Limb(1) << (BitIndex % LIMB_BITS);
+	}
+
+	constexpr void ClearBit(size_t BitIndex)
+	{
+		Data[BitIndex / LIMB_BITS] &= ~(Limb(1) << (BitIndex % LIMB_BITS));
+	}
+
+	constexpr FixedInt& operator+=(const FixedInt& other)
+	{
+		Limb carry = 0;
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] = FixedIntDetail::AddCarry(Data[i], other.Data[i], carry);
+		}
+		ClearUnusedBits();
+		return *this;
+	}
+
+	constexpr FixedInt& operator-=(const FixedInt& other)
+	{
+		Limb borrow = 0;
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] = FixedIntDetail::SubBorrow(Data[i], other.Data[i], borrow);
+		}
+		ClearUnusedBits();
+		return *this;
+	}
+
+	// 补码乘法的低 Bits 位与符号无关，直接做截断的 basecase 乘法
+	constexpr FixedInt& operator*=(const FixedInt& other)
+	{
+		Limb result[LimbCount] = {};
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Limb carry = 0;
+			for (size_t j = 0; i + j < LimbCount; ++j)
+			{
+				Limb hi = 0;
+				Limb lo = FixedIntDetail::MulHiLo(Data[i], other.Data[j], hi);
+				lo += carry;
+				hi += lo < carry;
+				lo += result[i + j];
+				hi += lo < result[i + j];
+				result[i + j] = lo;
+				carry = hi;
+			}
+		}
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] = result[i];
+		}
+		ClearUnusedBits();
+		return *this;
+	}
+
+	// 商向0取整，除数为0时抛出 std::domain_error
+	FixedInt& operator/=(const FixedInt& other)
+	{
+		FixedInt remainder;
+		DivRem(*this, other, *this, remainder);
+		return *this;
+	}
+
+	// 余数与被除数同号
+	FixedInt& operator%=(const FixedInt& other)
+	{
+		FixedInt quotient;
+		DivRem(*this, other, quotient, *this);
+		return *this;
+	}
+
+	constexpr FixedInt& operator&=(const FixedInt& other)
+	{
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] &= other.Data[i];
+		}
+		return *this;
+	}
+
+	constexpr FixedInt& operator|=(const FixedInt& other)
+	{
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] |= other.Data[i];
+		}
+		return *this;
+	}
+
+	constexpr FixedInt& operator^=(const FixedInt& other)
+	{
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Data[i] ^= other.Data[i];
+		}
+		return *this;
+	}
+
+	// 逻辑移位，与 Number 一致
+	constexpr FixedInt& operator<<=(size_t shift)
+	{
+		size_t limbShift = shift / LIMB_BITS;
+		size_t bitShift = shift % LIMB_BITS;
+		for (size_t i = LimbCount; i > 0; --i)
+		{
+			size_t index = i - 1;
+			Limb value = 0;
+			if (index >= limbShift)
+			{
+				value = Data[index - limbShift] << bitShift;
+				if (bitShift != 0 && index > limbShift)
+				{
+					value |= Data[index - limbShift - 1] >> (LIMB_BITS - bitShift);
+				}
+			}
+			Data[index] = value;
+		}
+		ClearUnusedBits();
+		return *this;
+	}
+
+	constexpr FixedInt& operator>>=(size_t shift)
+	{
+		size_t limbShift = shift / LIMB_BITS;
+		size_t bitShift = shift % LIMB_BITS;
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			Limb value = 0;
+			if (i + limbShift < LimbCount)
+			{
+				value = Data[i + limbShift] >> bitShift;
+				if (bitShift != 0 && i + limbShift + 1 < LimbCount)
+				{
+					value |= Data[i + limbShift + 1] << (LIMB_BITS - bitShift);
+				}
+			}
+			Data[i] = value;
+		}
+		return *this;
+	}
+
+	constexpr FixedInt operator-() const
+	{
+		FixedInt result;
+		result -= *this;
+		return result;
+	}
+
+	constexpr FixedInt operator~() const
+	{
+		FixedInt result;
+		for (size_t i = 0; i < LimbCount; ++i)
+		{
+			result.Data[i] = ~Data[i];
+		}
+		result.ClearUnusedBits();
+		return result;
+	}
+
+	constexpr FixedInt operator+(const FixedInt& other) const { FixedInt result(*this); result += other; return result; }
+	constexpr FixedInt operator-(const FixedInt& other) const { FixedInt result(*this); result -= other; return result; }
+	constexpr FixedInt operator*(const FixedInt& other) const { FixedInt result(*this); result *= other; return result; }
+	FixedInt operator/(const FixedInt& other) const { FixedInt result(*this); result /= other; return result; }
+	FixedInt operator%(const FixedInt& other) const { FixedInt result(*this); result %= other; return result; }
+	constexpr FixedInt operator&(const FixedInt& other) const { FixedInt result(*this); result &= other; return result; }
+	constexpr FixedInt operator|(const FixedInt& other) const { FixedInt result(*this); result |= other; return result; }
+	constexpr FixedInt operator^(const FixedInt& other) const { FixedInt result(*this); result ^= other; return result; }
+	constexpr FixedInt operator<<(size_t shift) const { FixedInt result(*this); result <<= shift; return result; }
+	constexpr FixedInt operator>>(size_t shift) const { FixedInt result(*this); result >>= shift; return result; }
+
+	// 有符号比较，返回 -1 / 0 / 1
+	constexpr int Compare(const FixedInt& other) const
+	{
+		if (IsNegative() != other.IsNegative())
+		{
+			return IsNegative() ? -1 : 1;
+		}
+		for (size_t i = LimbCount; i > 0; --i)
+		{
+			if (Data[i - 1] != other.Data[i - 1])
+			{
+				return Data[i - 1] > other.Data[i - 1] ? 1 : -1;
+			}
+		}
+		return 0;
+	}
+
+	constexpr bool operator==(const FixedInt& other) const { return Compare(other) == 0; }
+	constexpr bool operator!=(const FixedInt& other) const { return Compare(other) != 0; }
+	constexpr bool operator<(const FixedInt& other) const { return Compare(other) < 0; }
+	constexpr bool operator<=(const FixedInt& other) const { return Compare(other) <= 0; }
+	constexpr bool operator>(const FixedInt& other) const { return Compare(other) > 0; }
+	constexpr bool operator>=(const FixedInt& other) const { return Compare(other) >= 0; }
+
+private:
+	static constexpr Limb TopMask = Bits % LIMB_BITS == 0 ? ~Limb(0) : ((Limb(1) << (Bits % LIMB_BITS)) - 1);
+
+	Limb Data[LimbCount];
+
+	constexpr void ClearUnusedBits()
+	{
+		Data[LimbCount - 1] &= TopMask;
+	}
+
+	// 在绝对值上做 LimbOps::DivRem，再按符号修正商和余数
+	static void DivRem(const FixedInt& a, const FixedInt& b, FixedInt& quotient, FixedInt& remainder)
+	{
+		bool aNegative = a.IsNegative();
+		bool bNegative = b.IsNegative();
+		FixedInt dividend = aNegative ? -a : a;
+		FixedInt divisor = bNegative ? -b : b;
+
+		size_t an = LimbOps::Normalized(dividend.Data, LimbCount);
+		size_t bn = LimbOps::Normalized(divisor.Data, LimbCount);
+		if (bn == 0)
+		{
+			throw std::domain_error("Division by zero");
+		}
+
+		FixedInt q, r;
+		if (an < bn)
+		{
+			r = dividend;
+		}
+		else
+		{
+			LimbOps::DivRem(q.Data, r.Data, dividend.Data, an, divisor.Data, bn);
+		}
+
+		quotient = aNegative != bNegative ? -q : q;
+		remainder = aNegative ? -r : r;
+	}
+};
@@ -0,0 +1,277 @@
+#include "Instrument.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    typedef std::atomic<std::uint64_t> Counter;
+
+    // 只有所属线程写入，所以用普通的读和写代替原子加法，Collect 在其他线程读取时也不会有数据竞争
+    inline void Increase(Counter& counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct ThreadCounters
+    {
+        Counter Calls[Instrument::OpCount];
+        Counter Nanoseconds[Instrument::OpCount];
+        Counter Histogram[Instrument::OpCount][Instrument::HistogramBuckets];
+        Counter Allocations;
+        Counter AllocatedBytes;
+
+        ThreadCounters()
+        {
+            Clear();
+        }
+
+        void Clear()
+        {
+            for (size_t i = 0; i < Instrument::OpCount; ++i)
+            {
+                Calls[i].store(0, std::memory_order_relaxed);
+                Nanoseconds[i].store(0, std::memory_order_relaxed);
+                for (size_t j = 0; j < Instrument::HistogramBuckets; ++j)
+                {
+                    Histogram[i][j].store(0, std::memory_order_relaxed);
+                }
+            }
+            Allocations.store(0, std::memory_order_relaxed);
+            AllocatedBytes.store(0, std::memory_order_relaxed);
+        }
+
+        void AddTo(Instrument::Snapshot& total) const
+        {
+            for (size_t i = 0; i < Instrument::OpCount; ++i)
+            {
+                total.Ops[i].Calls += Calls[i].load(std::memory_order_relaxed);
+                total.Ops[i].Nanoseconds += Nanoseconds[i].load(std::memory_order_relaxed);
+                for (size_t j = 0; j < Instrument::HistogramBuckets; ++j)
+                {
+                    total.Ops[i].Histogram[j] += Histogram[i][j].load(std::memory_order_relaxed);
+                }
+            }
+            total.Allocations += Allocations.load(std::memory_order_relaxed);
+            total.AllocatedBytes += AllocatedBytes.load(std::memory_order_relaxed);
+        }
+    };
+
+    // 已退出线程的计数并入 Retired。对象有意不释放，其他全局对象析构时的线程退出仍可以安全地访问
+    struct Registry
+    {
+        std::mutex Mutex;
+        std::vector<ThreadCounters*> Live;
+        Instrument::Snapshot Retired;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+
+    struct ThreadSlot
+    {
+        ThreadCounters Counters;
+
+        ThreadSlot()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+            registry.Live.push_back(&Counters);
+        }
+
+        ~ThreadSlot()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+            Counters.AddTo(registry.Retired);
+            for (size_t i = 0; i < registry.Live.size(); ++i)
+            {
+                if (registry.Live[i] == &Counters)
+                {
+                    registry.Live.erase(registry.Live.begin() + i);
+                    break;
+                }
+            }
+        }
+    };
+
+    ThreadCounters& Local()
+    {
+        thread_local ThreadSlot slot;
+        return slot.Counters;
+    }
+
+    size_t Bucket(size_t limbs)
+    {
+        size_t bucket = 0;
+        while (limbs != 0 && bucket + 1 < Instrument::HistogramBuckets)
+        {
+            limbs >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    const char* const OpNames[Instrument::OpCount] = {
+        "add", "subtract", "multiply", "divide", "modulo", "compare", "shift", "bitwise", "parse", "tostring",
+        "mul_basecase", "mul_karatsuba", "mul_toom3", "mul_toom4", "mul_unbalanced", "mul_ntt",
+        "div_single_limb", "div_knuth", "div_burnikel_ziegler"
+    };
+
+    // 第 bucket 档的字数下限
+    unsigned long long BucketFloor(size_t bucket)
+    {
+        return bucket == 0 ? 0 : 1ULL << (bucket - 1);
+    }
+}
+
+const char* Instrument::OpName(Op op)
+{
+    return OpNames[static_cast<size_t>(op)];
+}
+
+bool Instrument::Enabled()
+{
+#if defined(BIGNUMBER_INSTRUMENT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Instrument::Record(Op op, size_t limbs, std::uint64_t nanoseconds)
+{
+    ThreadCounters& counters = Local();
+    size_t i = static_cast<size_t>(op);
+    Increase(counters.Calls[i], 1);
+    Increase(counters.Nanoseconds[i], nanoseconds);
+    Increase(counters.Histogram[i][Bucket(limbs)], 1);
+}
+
+void Instrument::RecordAllocation(size_t bytes)
+{
+    ThreadCounters& counters = Local();
+    Increase(counters.Allocations, 1);
+    Increase(counters.AllocatedBytes, bytes);
+}
+
+Instrument::Snapshot Instrument::Collect()
+{
+    Snapshot total;
+    std::memset(&total, 0, sizeof(total));
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    total = registry.Retired;
+    for (const ThreadCounters* counters : registry.Live)
+    {
+        counters->AddTo(total);
+    }
+    return total;
+}
+
+void Instrument::Reset()
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    std::memset(&registry.Retired, 0, sizeof(registry.Retired));
+    for (ThreadCounters* counters : registry.Live)
+    {
+        counters->Clear();
+    }
+}
+
+Instrument::Snapshot Instrument::operator-(const Snapshot& later, const Snapshot& earlier)
+{
+    Snapshot result = later;
+    for (size_t i = 0; i < OpCount; ++i)
+    {
+        result.Ops[i].Calls -= earlier.Ops[i].Calls;
+        result.Ops[i].Nanoseconds -= earlier.Ops[i].Nanoseconds;
+        for (size_t j = 0; j < HistogramBuckets; ++j)
+        {
+            result.Ops[i].Histogram[j] -= earlier.Ops[i].Histogram[j];
+        }
+    }
+    result.Allocations -= earlier.Allocations;
+    result.AllocatedBytes -= earlier.AllocatedBytes;
+    return result;
+}
+
+std::string Instrument::Snapshot::ToText() const
+{
+    std::string text;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-22s %14s %16s %12s  %s\n", "op", "calls", "total ns", "ns/call", "limbs: calls");
+    text += line;
+
+    for (size_t i = 0; i < OpCount; ++i)
+    {
+        const OpStats& stats = Ops[i];
+        if (stats.Calls == 0)
+        {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "%-22s %14llu %16llu %12.1f ", OpNames[i],
+            static_cast<unsigned long long>(stats.Calls), static_cast<unsigned long long>(stats.Nanoseconds),
+            static_cast<double>(stats.Nanoseconds) / static_cast<double>(stats.Calls));
+        text += line;
+        for (size_t j = 0; j < HistogramBuckets; ++j)
+        {
+            if (stats.Histogram[j] != 0)
+            {
+                std::snprintf(line, sizeof(line), " %llu+:%llu", BucketFloor(j), static_cast<unsigned long long>(stats.Histogram[j]));
+                text += line;
+            }
+        }
+        text += '\n';
+    }
+
+    std::snprintf(line, sizeof(line), "allocations %llu, %llu bytes\n",
+        static_cast<unsigned long long>(Allocations), static_cast<unsigned long long>(AllocatedBytes));
+    text += line;
+    return text;
+}
+
+std::string Instrument::Snapshot::ToJson() const
+{
+    std::string json = "{\n  \"ops\": {";
+    char item[160];
+    bool first = true;
+    for (size_t i = 0; i < OpCount; ++i)
+    {
+        const OpStats& stats = Ops[i];
+        if (stats.Calls == 0)
+        {
+            continue;
+        }
+        std::snprintf(item, sizeof(item), "%s\n    \"%s\": {\"calls\": %llu, \"ns\": %llu, \"limbs_histogram\": {",
+            first ? "" : ",", OpNames[i], static_cast<unsigned long long>(stats.Calls), static_cast<unsigned long long>(stats.Nanoseconds));
+        json += item;
+        first = false;
+
+        // 键为该档字数的下限
+        bool firstBucket = true;
+        for (size_t j = 0; j < HistogramBuckets; ++j)
+        {
+            if (stats.Histogram[j] != 0)
+            {
+                std::snprintf(item, sizeof(item), "%s\"%llu\": %llu", firstBucket ? "" : ", ", BucketFloor(j),
+                    static_cast<unsigned long long>(stats.Histogram[j]));
+                json += item;
+                firstBucket = false;
+            }
+        }
+        json += "}}";
+    }
+
+    std::snprintf(item, sizeof(item), "\n  },\n  \"allocations\": %llu,\n  \"allocated_bytes\": %llu\n}\n",
+        static_cast<unsigned long long>(Allocations), static_cast<unsigned long long>(AllocatedBytes));
+    json += item;
+    return json;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 可选的运行统计：各运算的调用次数、累计耗时、操作数规模的分布，以及堆分配的次数与字节数。
+// 默认不编译进库，定义 BIGNUMBER_INSTRUMENT（CMake 选项 BIGNUMBER_INSTRUMENT=ON）后才生效，
+// 否则下面的宏展开为空，库的代码与没有统计时完全相同；Collect 等函数始终可用，只是结果全为0。
+//
+// 统计先累加在各线程自己的计数器里（不加锁），Collect 时再汇总所有线程（包括已退出的线程）
+namespace Instrument
+{
+	enum class Op
+	{
+		// 公开运算，统计次数、累计耗时（包含其中调用的其他运算）与操作数字数
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Modulo,
+		Compare,
+		Shift,
+		Bitwise,
+		Parse,
+		ToString,
+		// 内部算法的选择，只统计次数与字数，递归中的每一层都计入
+		MulBasecase,
+		MulKaratsuba,
+		MulToom3,
+		MulToom4,
+		MulUnbalanced,
+		MulNtt,
+		DivSingleLimb,
+		DivKnuth,
+		DivBurnikelZiegler,
+		Count
+	};
+
+	const size_t OpCount = static_cast<size_t>(Op::Count);
+	// 第 i 档是字数在 [2^(i-1), 2^i) 内的操作（第0档为0个字），最后一档包括更大的
+	const size_t HistogramBuckets = 28;
+
+	const char* OpName(Op op);
+
+	struct OpStats
+	{
+		std::uint64_t Calls;
+		std::uint64_t Nanoseconds;
+		std::uint64_t Histogram[HistogramBuckets];
+	};
+
+	struct Snapshot
+	{
+		OpStats Ops[OpCount];
+		std::uint64_t Allocations;
+		std::uint64_t AllocatedBytes;
+
+		std::string ToText() const;   // 每个有调用的运算一行，后面是非空的字数分布
+		std::string ToJson() const;
+	};
+
+	// 两次快照之差，用来统计一段代码的开销
+	Snapshot operator-(const Snapshot& later, const Snapshot& earlier);
+
+	bool Enabled();      // 编译时是否定义了 BIGNUMBER_INSTRUMENT
+	Snapshot Collect();  // 所有线程的累计值
+	// 清零所有线程的计数。其他线程正在运算时，与清零同时发生的少量更新可能丢失
+	void Reset();
+
+	void Record(Op op, size_t limbs, std::uint64_t nanoseconds);
+	void RecordAllocation(size_t bytes);
+
+	// 作用域计时：析构时记录一次调用（异常退出同样记录）
+	class Scope
+	{
+	public:
+		Scope(Op op, size_t limbs) :Operation(op), Limbs(limbs), Start(std::chrono::steady_clock::now()) {}
+		~Scope()
+		{
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - Start;
+			Record(Operation, Limbs, static_cast<std::uint64_t>(elapsed.count()));
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Op Operation;
+		size_t Limbs;
+		std::chrono::steady_clock::time_point Start;
+	};
+}
+
+#if defined(BIGNUMBER_INSTRUMENT)
+#define INSTRUMENT_SCOPE(op, limbs) Instrument::Scope instrumentScope((op), (limbs))
+#define INSTRUMENT_COUNT(op, limbs) Instrument::Record((op), (limbs), 0)
+#define INSTRUMENT_ALLOCATION(bytes) Instrument::RecordAllocation(bytes)
+#else
+#define INSTRUMENT_SCOPE(op, limbs) ((void)0)
+#define INSTRUMENT_COUNT(op, limbs) ((void)0)
+#define INSTRUMENT_ALLOCATION(bytes) ((void)0)
+#endif
@@ -0,0 +1,215 @@
+#include "LimbOps.h"
+
+Limb LimbOps::Add(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    unsigned char carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = AddCarry(a[i], b[i], carry);
+    }
+    return carry;
+}
+
+Limb LimbOps::Sub(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    unsigned char borrow = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = SubBorrow(a[i], b[i], borrow);
+    }
+    return borrow;
+}
+
+Limb LimbOps::Add1(Limb* r, const Limb* a, size_t n, Limb b)
+{
+    // 进位消失后其余的字不变，原地运算时直接返回
+    size_t i = 0;
+    for (; i < n && b != 0; ++i)
+    {
+        Limb sum = a[i] + b;
+        b = sum < b ? 1 : 0;
+        r[i] = sum;
+    }
+    if (r != a)
+    {
+        for (; i < n; ++i)
+        {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+
+Limb LimbOps::Sub1(Limb* r, const Limb* a, size_t n, Limb b)
+{
+    size_t i = 0;
+    for (; i < n && b != 0; ++i)
+    {
+        Limb difference = a[i] - b;
+        b = a[i] < b ? 1 : 0;
+        r[i] = difference;
+    }
+    if (r != a)
+    {
+        for (; i < n; ++i)
+        {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+
+Limb LimbOps::Negate(Limb* r, const Limb* a, size_t n)
+{
+    // 找到最低的非0字：它之前的字保持为0，它本身取负，之后的字按位取反
+    size_t i = 0;
+    while (i < n && a[i] == 0)
+    {
+        r[i] = 0;
+        ++i;
+    }
+    if (i == n)
+    {
+        return 0;
+    }
+
+    r[i] = ~a[i] + 1;
+    for (++i; i < n; ++i)
+    {
+        r[i] = ~a[i];
+    }
+    return 1;
+}
+
+void LimbOps::SignExtend(Limb* r, size_t n, const Limb* a, size_t bits)
+{
+    size_t an = LimbCount(bits);
+    if (n < an)
+    {
+        // 截断：高位直接丢弃
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i];
+        }
+        return;
+    }
+
+    Limb fill = 0;
+    if (an > 0)
+    {
+        fill = ((a[an - 1] >> ((bits - 1) % LIMB_BITS)) & 1) != 0 ? ~Limb(0) : 0;
+        for (size_t i = 0; i + 1 < an; ++i)
+        {
+            r[i] = a[i];
+        }
+        r[an - 1] = a[an - 1] | (fill & ~TopMask(bits));
+    }
+    for (size_t i = an; i < n; ++i)
+    {
+        r[i] = fill;
+    }
+}
+
+Limb LimbOps::Mul1(Limb* r, const Limb* a, size_t n, Limb b)
+{
+    Limb carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        Limb hi;
+        Limb lo = MulHiLo(a[i], b, hi);
+        lo += carry;
+        carry = hi + (lo < carry);
+        r[i] = lo;
+    }
+    return carry;
+}
+
+Limb LimbOps::AddMul1(Limb* r, const Limb* a, size_t n, Limb b)
+{
+    Limb carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        Limb hi;
+        Limb lo = MulHiLo(a[i], b, hi);
+        lo += carry;
+        hi += (lo < carry);
+        lo += r[i];
+        hi += (lo < r[i]);
+        r[i] = lo;
+        carry = hi;
+    }
+    return carry;
+}
+
+Limb LimbOps::SubMul1(Limb* r, const Limb* a, size_t n, Limb b)
+{
+    Limb borrow = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        Limb hi;
+        Limb lo = MulHiLo(a[i], b, hi);
+        lo += borrow;
+        hi += (lo < borrow);
+        Limb value = r[i];
+        r[i] = value - lo;
+        borrow = hi + (value < lo);
+    }
+    return borrow;
+}
+
+Limb LimbOps::DivRem1(Limb* q, const Limb* a, size_t n, Limb d)
+{
+    Limb rem = 0;
+    for (size_t i = n; i > 0; --i)
+    {
+        q[i - 1] = DivHiLo(rem, a[i - 1], d, rem);
+    }
+    return rem;
+}
+
+int LimbOps::Compare(const Limb* a, const Limb* b, size_t n)
+{
+    for (size_t i = n; i > 0; --i)
+    {
+        if (a[i - 1] != b[i - 1])
+        {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+bool LimbOps::IsZero(const Limb* a, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (a[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LimbOps::Magnitude(Limb* r, const Limb* a, size_t BitSize)
+{
+    size_t n = LimbCount(BitSize);
+    if (n == 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = a[i];
+    }
+    r[n - 1] &= TopMask(BitSize);
+
+    bool negative = ((r[n - 1] >> ((BitSize - 1) % LIMB_BITS)) & 1) != 0;
+    if (negative)
+    {
+        Negate(r, r, n);
+        r[n - 1] &= TopMask(BitSize);
+    }
+    return negative;
+}
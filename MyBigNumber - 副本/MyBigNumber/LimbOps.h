@@ -0,0 +1,316 @@
+#pragma once
+#include "Instrument.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// 一个字（limb），数据按字存储，下标0为最低位字
+typedef std::uint64_t Limb;
+
+#define LIMB_BITS 64
+
+namespace LimbOps
+{
+	// 存放 BitSize 位需要的字数
+	inline size_t LimbCount(size_t BitSize)
+	{
+		return (BitSize + LIMB_BITS - 1) / LIMB_BITS;
+	}
+
+	// 最高字中有效位的掩码
+	inline Limb TopMask(size_t BitSize)
+	{
+		size_t used = BitSize % LIMB_BITS;
+		return used == 0 ? ~Limb(0) : ((Limb(1) << used) - 1);
+	}
+
+	// 带进位加法：返回 a + b + carry 的低64位，carry 更新为新的进位
+	inline Limb AddCarry(Limb a, Limb b, unsigned char& carry)
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		unsigned long long out;
+		carry = _addcarry_u64(carry, a, b, &out);
+		return out;
+#else
+		Limb s = a + b;
+		Limb c1 = s < a;
+		Limb r = s + carry;
+		Limb c2 = r < s;
+		carry = static_cast<unsigned char>(c1 | c2);
+		return r;
+#endif
+	}
+
+	// 带借位减法：返回 a - b - borrow 的低64位，borrow 更新为新的借位
+	inline Limb SubBorrow(Limb a, Limb b, unsigned char& borrow)
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		unsigned long long out;
+		borrow = _subborrow_u64(borrow, a, b, &out);
+		return out;
+#else
+		Limb d = a - b;
+		Limb b1 = a < b;
+		Limb r = d - borrow;
+		Limb b2 = d < borrow;
+		borrow = static_cast<unsigned char>(b1 | b2);
+		return r;
+#endif
+	}
+
+	// 64x64 -> 128 位乘法：返回低64位，高64位写入 hi
+	inline Limb MulHiLo(Limb a, Limb b, Limb& hi)
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+		hi = static_cast<Limb>(p >> 64);
+		return static_cast<Limb>(p);
+#elif defined(_M_X64)
+		unsigned long long h;
+		Limb lo = _umul128(a, b, &h);
+		hi = h;
+		return lo;
+#else
+		Limb al = a & 0xFFFFFFFF, ah = a >> 32;
+		Limb bl = b & 0xFFFFFFFF, bh = b >> 32;
+		Limb ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+		Limb mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+		hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+		return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+	}
+
+	// 前导0的个数，x 不能为0
+	inline unsigned CountLeadingZeros(Limb x)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, x);
+		return 63 - index;
+#elif defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_clzll(x));
+#else
+		unsigned n = 0;
+		while ((x & (Limb(1) << (LIMB_BITS - 1))) == 0)
+		{
+			x <<= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	// 末尾0的个数，x 不能为0
+	inline unsigned CountTrailingZeros(Limb x)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, x);
+		return index;
+#elif defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+		unsigned n = 0;
+		while ((x & 1) == 0)
+		{
+			x >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	// 单字中1的个数。POPCNT 指令需要运行时检测，这里用与 CPU 无关的写法，数组版本 PopCount 按 CPU 选择
+	inline unsigned PopCount(Limb x)
+	{
+#if defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<unsigned>((x * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	// 128/64 位除法：(hi:lo) / d，要求 hi < d，余数写入 rem
+	inline Limb DivHiLo(Limb hi, Limb lo, Limb d, Limb& rem)
+	{
+#if defined(__x86_64__) && defined(__GNUC__)
+		Limb q;
+		__asm__("divq %4" : "=a"(q), "=d"(rem) : "a"(lo), "d"(hi), "rm"(d));
+		return q;
+#elif defined(__SIZEOF_INT128__)
+		unsigned __int128 n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+		rem = static_cast<Limb>(n % d);
+		return static_cast<Limb>(n / d);
+#elif defined(_M_X64) && _MSC_VER >= 1920
+		unsigned long long r;
+		Limb q = _udiv128(hi, lo, d, &r);
+		rem = r;
+		return q;
+#else
+		// 逐位试商
+		Limb q = 0;
+		for (int i = 0; i < LIMB_BITS; ++i)
+		{
+			Limb top = hi >> (LIMB_BITS - 1);
+			hi = (hi << 1) | (lo >> (LIMB_BITS - 1));
+			lo <<= 1;
+			q <<= 1;
+			if (top || hi >= d)
+			{
+				hi -= d;
+				q |= 1;
+			}
+		}
+		rem = hi;
+		return q;
+#endif
+	}
+
+	// 临时字缓冲区：尺寸较小时放在栈上，避免堆分配
+	class TempLimbs
+	{
+	public:
+		explicit TempLimbs(size_t n) :Size(n), Ptr(n <= InlineCount ? Inline : Allocate(n)) {}
+		~TempLimbs() { if (Ptr != Inline) delete[] Ptr; }
+		TempLimbs(const TempLimbs&) = delete;
+		TempLimbs& operator=(const TempLimbs&) = delete;
+
+		Limb* data() { return Ptr; }
+		size_t size() const { return Size; }
+		Limb& operator[](size_t i) { return Ptr[i]; }
+
+	private:
+		static const size_t InlineCount = 32;
+		size_t Size;
+		Limb Inline[InlineCount];
+		Limb* Ptr;
+
+		static Limb* Allocate(size_t n)
+		{
+			INSTRUMENT_ALLOCATION(n * sizeof(Limb));
+			return new Limb[n];
+		}
+	};
+
+	// r = a + b，返回最高位进位。r 可以与 a 或 b 相同
+	Limb Add(Limb* r, const Limb* a, const Limb* b, size_t n);
+	// r = a - b，返回最高位借位。r 可以与 a 或 b 相同
+	Limb Sub(Limb* r, const Limb* a, const Limb* b, size_t n);
+	// r = a + b（单字），返回最高位进位。r 可以与 a 相同，此时进位停止后不再访问其余的字
+	Limb Add1(Limb* r, const Limb* a, size_t n, Limb b);
+	// r = a - b（单字），返回最高位借位。r 可以与 a 相同
+	Limb Sub1(Limb* r, const Limb* a, size_t n, Limb b);
+	// r = -a（补码取反加一），a 为0时返回0，否则返回1
+	Limb Negate(Limb* r, const Limb* a, size_t n);
+	// 把 bits 位的补码数 a 符号扩展（或截断）到 r[0..n)。r 可以与 a 相同
+	void SignExtend(Limb* r, size_t n, const Limb* a, size_t bits);
+
+	// 位运算与移位的 SIMD 级别。启动时按 CPUID 选择 CPU 支持的最高级别，
+	// SetSimdLevel 可以降到更低的级别（用于对比测试），不能超过 CPU 支持的级别
+	enum class SimdLevel
+	{
+		Scalar,
+		Sse2,
+		Avx2,
+		Avx512
+	};
+	SimdLevel GetSimdLevel();
+	void SetSimdLevel(SimdLevel level);
+
+	void And(Limb* r, const Limb* a, const Limb* b, size_t n);
+	void Or(Limb* r, const Limb* a, const Limb* b, size_t n);
+	void Xor(Limb* r, const Limb* a, const Limb* b, size_t n);
+	void Not(Limb* r, const Limb* a, size_t n);
+
+	// a[0..n) 中1的个数。CPU 支持时使用 POPCNT 指令
+	size_t PopCount(const Limb* a, size_t n);
+	// 从第 from 位开始（含）向高位找第一个为1的位，没有时返回 n * LIMB_BITS
+	size_t FindNextSet(const Limb* a, size_t n, size_t from);
+	// 最高的1所在位置加一，全为0时返回0
+	size_t BitLength(const Limb* a, size_t n);
+	// 取出第 pos 位开始的 count 位（count <= 64），可以跨两个字。调用方保证不越界
+	Limb ExtractBits(const Limb* a, size_t pos, size_t count);
+	// 把 value 的低 count 位写到第 pos 位开始的位置（count <= 64），其余位不变
+	void InsertBits(Limb* a, size_t pos, size_t count, Limb value);
+
+	// r = a << shift（逻辑移位，超出 n 个字的部分丢弃）。r 可以与 a 相同
+	void ShiftLeft(Limb* r, const Limb* a, size_t n, size_t shift);
+	// r = a >> shift（逻辑移位，高位补0）。r 可以与 a 相同
+	void ShiftRight(Limb* r, const Limb* a, size_t n, size_t shift);
+
+	// r = a * b（单字），返回最高位字
+	Limb Mul1(Limb* r, const Limb* a, size_t n, Limb b);
+	// r += a * b（单字），返回最高位进位字
+	Limb AddMul1(Limb* r, const Limb* a, size_t n, Limb b);
+	// r -= a * b（单字），返回最高位借位字
+	Limb SubMul1(Limb* r, const Limb* a, size_t n, Limb b);
+	// q = a / d（单字），返回余数。q 可以与 a 相同
+	Limb DivRem1(Limb* q, const Limb* a, size_t n, Limb d);
+
+	// 大数乘法（以及通过乘法受益的除法）使用的线程数，默认为1即串行，0 表示使用全部硬件线程。
+	// 多线程只把互不依赖的子乘积分给工作窃取线程池，结果与串行完全相同。不能在运算进行中修改
+	void SetThreadCount(size_t count);
+	size_t GetThreadCount();
+
+	// r[0..an+bn) = a * b，按规模自动选择 basecase / Karatsuba / Toom-3 / Toom-4。
+	// r 不能与 a、b 重叠
+	void Mul(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn);
+	// r[0..2n) = a^2，交叉积只算一次，比 Mul(r, a, n, a, n) 少约一半的字乘法（很大时与 Mul 相同）。r 不能与 a 重叠
+	void Sqr(Limb* r, const Limb* a, size_t n);
+	// r[0..an+bn) = a * b，三素数 NTT 实现，用于非常大的操作数。r 不能与 a、b 重叠
+	void MulNtt(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn);
+	// r[0..n) = (a * b) 的低 n 个字，a、b 均为 n 个字。r 不能与 a、b 重叠
+	void MulLow(Limb* r, const Limb* a, const Limb* b, size_t n);
+
+	// q[0..an-bn+1) = a / b，r[0..bn) = a % b。要求 an >= bn 且 b 最高字非0，
+	// 按规模选择 Knuth 算法 D 或 Burnikel-Ziegler 递归除法。q、r 不能与 a、b 重叠
+	void DivRem(Limb* q, Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn);
+
+	// 把无符号数 a 的十进制表示追加到 out。小数逐次除以 10^19，大数按缓存的10的幂分治
+	void ToDecimal(std::string& out, const Limb* a, size_t n);
+	// 接收按块输出的文本，每次给出一段连续的字符（不以 '\0' 结尾）
+	typedef std::function<void(const char* text, size_t length)> TextSink;
+	// 把无符号数 a 的 radix 进制（2~36）表示按不超过 4KB 的块写到 sink，字母用小写（uppercase 时用大写）。
+	// 十进制与 ToDecimal 相同，2 的幂进制直接按位映射，其他进制逐次除以单字
+	void WriteDigits(const TextSink& sink, const Limb* a, size_t n, int radix, bool uppercase);
+	// BitSize 位无符号数的 radix 进制表示的位数上界，只与位宽有关
+	size_t DigitCountBound(size_t BitSize, int radix);
+	// 把 radix 进制（2~36，不含符号）的数字串解析到 r[0..n)，超出 n 个字的高位丢弃。
+	// 2 的幂进制直接按位映射，十进制每次读入19位、很长时分治，含非法字符时抛出 std::invalid_argument
+	void FromString(Limb* r, size_t n, const char* digits, size_t len, int radix);
+
+	// 去掉高位的0字后的长度
+	inline size_t Normalized(const Limb* a, size_t n)
+	{
+		while (n > 0 && a[n - 1] == 0)
+		{
+			--n;
+		}
+		return n;
+	}
+
+	// 无符号比较，返回 -1 / 0 / 1
+	int Compare(const Limb* a, const Limb* b, size_t n);
+	// 判断是否全为0
+	bool IsZero(const Limb* a, size_t n);
+
+	// 以下是 BitSize 位补码数的有符号运算。a、b、r、q 都是 LimbCount(BitSize) 个字，
+	// 输入最高字中超出 BitSize 的位被忽略，结果按 BitSize 位回绕并清除这些位
+	// r = |a|，返回 a 是否为负数。r 可以与 a 相同
+	bool Magnitude(Limb* r, const Limb* a, size_t BitSize);
+	// r = a * b。r 可以与 a、b 相同
+	void SignedMulLow(Limb* r, const Limb* a, const Limb* b, size_t BitSize);
+	// q = a / b（向0取整），r = a % b（与 a 同号），q、r 可以为空，也可以与 a、b 相同。
+	// b 为0时抛出 std::domain_error
+	void SignedDivRem(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t BitSize);
+}
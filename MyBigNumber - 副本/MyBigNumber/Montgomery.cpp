@@ -0,0 +1,263 @@
+#include "Montgomery.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // 滑动窗口宽度：预计算 2^(k-1) 个奇数次幂，指数越长窗口越宽
+    unsigned WindowBits(size_t exponentBits)
+    {
+        if (exponentBits > 2048)
+        {
+            return 6;
+        }
+        if (exponentBits > 512)
+        {
+            return 5;
+        }
+        if (exponentBits > 128)
+        {
+            return 4;
+        }
+        if (exponentBits > 24)
+        {
+            return 3;
+        }
+        return 1;
+    }
+
+    int ExponentBit(const Limb* e, size_t index)
+    {
+        return static_cast<int>((e[index / LIMB_BITS] >> (index % LIMB_BITS)) & 1);
+    }
+}
+
+MontgomeryContext::MontgomeryContext(const BigInt& modulus)
+    :Modulus(modulus), BitSize(modulus.GetBitSize()), Size(0), NegInverse(0)
+{
+    const Limb* m = modulus.GetData();
+    if (modulus.GetBit(BitSize - 1) == 1 || (m[0] & 1) == 0)
+    {
+        throw std::invalid_argument("Montgomery modulus must be positive and odd");
+    }
+
+    Size = LimbOps::Normalized(m, modulus.GetLimbCount());
+    M.assign(m, m + Size);
+
+    // Newton 迭代求 m^(-1) mod 2^64，每次有效位数翻倍（初值已有3位正确）
+    Limb inverse = M[0];
+    for (int i = 0; i < 5; ++i)
+    {
+        inverse *= 2 - M[0] * inverse;
+    }
+    NegInverse = Limb(0) - inverse;
+
+    // R^2 mod m：对 2^(128*n) 做一次除法
+    std::vector<Limb> power(2 * Size + 1, 0), quotient(Size + 2);
+    power[2 * Size] = 1;
+    R2.resize(Size);
+    LimbOps::DivRem(quotient.data(), R2.data(), power.data(), power.size(), M.data(), Size);
+
+    // R mod m = REDC(R^2)
+    std::vector<Limb> scratch(2 * Size + 1, 0);
+    std::copy(R2.begin(), R2.end(), scratch.begin());
+    One.resize(Size);
+    Redc(One.data(), scratch.data());
+}
+
+const BigInt& MontgomeryContext::GetModulus() const
+{
+    return Modulus;
+}
+
+void MontgomeryContext::Redc(Limb* r, Limb* t) const
+{
+    // 每一步加上 q*m 使最低字变为0，n 步之后整体右移 n 个字
+    for (size_t i = 0; i < Size; ++i)
+    {
+        Limb q = t[i] * NegInverse;
+        Limb carry = LimbOps::AddMul1(t + i, M.data(), Size, q);
+        for (size_t k = i + Size; carry != 0; ++k)
+        {
+            t[k] += carry;
+            carry = t[k] < carry ? 1 : 0;
+        }
+    }
+
+    // 此时 t[n..2n] < 2m，最多再减一次 m
+    Limb* high = t + Size;
+    if (high[Size] != 0 || LimbOps::Compare(high, M.data(), Size) >= 0)
+    {
+        LimbOps::Sub(r, high, M.data(), Size);
+    }
+    else
+    {
+        std::copy(high, high + Size, r);
+    }
+}
+
+void MontgomeryContext::MulRedc(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const
+{
+    LimbOps::Mul(scratch, a, Size, b, Size);
+    scratch[2 * Size] = 0;
+    Redc(r, scratch);
+}
+
+void MontgomeryContext::SqrRedc(Limb* r, const Limb* a, Limb* scratch) const
+{
+    LimbOps::Sqr(scratch, a, Size);
+    scratch[2 * Size] = 0;
+    Redc(r, scratch);
+}
+
+std::vector<Limb> MontgomeryContext::Reduce(const BigInt& x) const
+{
+    BigInt remainder = x % Modulus;
+    if (remainder.GetBit(BitSize - 1) == 1)
+    {
+        remainder += Modulus;
+    }
+    return std::vector<Limb>(remainder.GetData(), remainder.GetData() + Size);
+}
+
+BigInt MontgomeryContext::ToBigInt(const Limb* value, bool valid) const
+{
+    std::vector<Limb> limbs(LimbOps::LimbCount(BitSize), 0);
+    std::copy(value, value + Size, limbs.begin());
+    BigInt result(limbs.data(), BitSize);
+    if (!valid)
+    {
+        result.MarkInvalidFrom(0);
+    }
+    return result;
+}
+
+BigInt MontgomeryContext::ToMontgomery(const BigInt& x) const
+{
+    std::vector<Limb> value = Reduce(x);
+    std::vector<Limb> scratch(2 * Size + 1);
+    MulRedc(value.data(), value.data(), R2.data(), scratch.data());
+    return ToBigInt(value.data(), x.IsValid());
+}
+
+BigInt MontgomeryContext::FromMontgomery(const BigInt& x) const
+{
+    if (x.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+
+    std::vector<Limb> scratch(2 * Size + 1, 0);
+    std::copy(x.GetData(), x.GetData() + Size, scratch.begin());
+    std::vector<Limb> value(Size);
+    Redc(value.data(), scratch.data());
+    return ToBigInt(value.data(), x.IsValid());
+}
+
+BigInt MontgomeryContext::Multiply(const BigInt& a, const BigInt& b) const
+{
+    if (a.GetBitSize() != BitSize || b.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+
+    std::vector<Limb> value(Size), scratch(2 * Size + 1);
+    MulRedc(value.data(), a.GetData(), b.GetData(), scratch.data());
+    return ToBigInt(value.data(), a.IsValid() && b.IsValid());
+}
+
+BigInt MontgomeryContext::Square(const BigInt& a) const
+{
+    if (a.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+
+    std::vector<Limb> value(Size), scratch(2 * Size + 1);
+    SqrRedc(value.data(), a.GetData(), scratch.data());
+    return ToBigInt(value.data(), a.IsValid());
+}
+
+BigInt MontgomeryContext::Pow(const BigInt& base, const BigInt& exponent) const
+{
+    if (exponent.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+    if (exponent.GetBit(BitSize - 1) == 1)
+    {
+        throw std::invalid_argument("Exponent must not be negative");
+    }
+
+    const Limb* e = exponent.GetData();
+    size_t en = LimbOps::Normalized(e, exponent.GetLimbCount());
+    size_t exponentBits = en == 0 ? 0 : en * LIMB_BITS - LimbOps::CountLeadingZeros(e[en - 1]);
+
+    // 指数为0时下面的循环不执行，结果就是1
+    std::vector<Limb> scratch(2 * Size + 1);
+    std::vector<Limb> result(One);
+
+    // table[i] = base^(2i+1)（Montgomery 形式）
+    unsigned window = WindowBits(exponentBits);
+    std::vector<std::vector<Limb>> table(size_t(1) << (window - 1));
+    table[0] = Reduce(base);
+    MulRedc(table[0].data(), table[0].data(), R2.data(), scratch.data());
+    if (table.size() > 1)
+    {
+        std::vector<Limb> square(Size);
+        SqrRedc(square.data(), table[0].data(), scratch.data());
+        for (size_t i = 1; i < table.size(); ++i)
+        {
+            table[i].resize(Size);
+            MulRedc(table[i].data(), table[i - 1].data(), square.data(), scratch.data());
+        }
+    }
+
+    // 自高位向低位扫描：遇到0平方一次；遇到1取不超过 window 位、以1结尾的最长窗口
+    size_t i = exponentBits;
+    bool started = false;
+    while (i > 0)
+    {
+        if (ExponentBit(e, i - 1) == 0)
+        {
+            if (started)
+            {
+                SqrRedc(result.data(), result.data(), scratch.data());
+            }
+            --i;
+            continue;
+        }
+
+        size_t length = std::min<size_t>(window, i);
+        while (ExponentBit(e, i - length) == 0)
+        {
+            --length;
+        }
+        size_t value = 0;
+        for (size_t k = 0; k < length; ++k)
+        {
+            value = (value << 1) | ExponentBit(e, i - 1 - k);
+        }
+
+        if (started)
+        {
+            for (size_t k = 0; k < length; ++k)
+            {
+                SqrRedc(result.data(), result.data(), scratch.data());
+            }
+            MulRedc(result.data(), result.data(), table[value >> 1].data(), scratch.data());
+        }
+        else
+        {
+            result = table[value >> 1];
+            started = true;
+        }
+        i -= length;
+    }
+
+    // 转回普通形式
+    std::fill(scratch.begin(), scratch.end(), 0);
+    std::copy(result.begin(), result.end(), scratch.begin());
+    Redc(result.data(), scratch.data());
+    return ToBigInt(result.data(), base.IsValid() && exponent.IsValid());
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include <vector>
+
+// 奇数模数 m 下的 Montgomery 运算，R = 2^(64*n)，n 为 m 的有效字数。
+// x 的 Montgomery 形式为 x*R mod m，两个 Montgomery 形式的数相乘后只需一次 REDC 约简，不需要做除法。
+// 所有 BigInt 参数与结果的位宽都等于模数的位宽，Montgomery 形式的值在 [0, m) 内
+class MontgomeryContext
+{
+public:
+	// modulus 必须为正奇数，否则抛出 std::invalid_argument
+	explicit MontgomeryContext(const BigInt& modulus);
+
+	const BigInt& GetModulus() const;
+
+	// 普通形式 -> Montgomery 形式（x 可以为负数或不小于 m，先约简到 [0, m)）
+	BigInt ToMontgomery(const BigInt& x) const;
+	// Montgomery 形式 -> 普通形式
+	BigInt FromMontgomery(const BigInt& x) const;
+
+	// Montgomery 形式的乘法与平方，结果仍为 Montgomery 形式
+	BigInt Multiply(const BigInt& a, const BigInt& b) const;
+	BigInt Square(const BigInt& a) const;
+
+	// base^exponent mod m，base 与结果均为普通形式，exponent 不能为负。使用滑动窗口法
+	BigInt Pow(const BigInt& base, const BigInt& exponent) const;
+
+private:
+	BigInt Modulus;
+	size_t BitSize;
+	size_t Size;              // m 的有效字数 n
+	std::vector<Limb> M;      // m，n 个字
+	Limb NegInverse;          // -m^(-1) mod 2^64
+	std::vector<Limb> R2;     // R^2 mod m
+	std::vector<Limb> One;    // R mod m，即1的 Montgomery 形式
+
+	// r = a * b * R^(-1) mod m，a、b、r 均为 n 个字，r 可以与 a、b 相同。scratch 至少 2n+1 个字
+	void MulRedc(Limb* r, const Limb* a, const Limb* b, Limb* scratch) const;
+	// r = a^2 * R^(-1) mod m，用 LimbOps::Sqr 计算乘积，其余与 MulRedc 相同
+	void SqrRedc(Limb* r, const Limb* a, Limb* scratch) const;
+	// r = t * R^(-1) mod m，t 为 2n+1 个字（会被修改），要求 t < m*R
+	void Redc(Limb* r, Limb* t) const;
+
+	std::vector<Limb> Reduce(const BigInt& x) const;   // x mod m，n 个字
+	BigInt ToBigInt(const Limb* value, bool valid) const;   // valid 为 false 时结果全部无效
+};
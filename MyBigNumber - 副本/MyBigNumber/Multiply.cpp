@@ -0,0 +1,680 @@
+#include "LimbOps.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// 各乘法算法的切换阈值（单位：字，按较短的操作数计），可在编译时覆盖
+#ifndef MUL_KARATSUBA_THRESHOLD
+#define MUL_KARATSUBA_THRESHOLD 32
+#endif
+
+#ifndef MUL_TOOM3_THRESHOLD
+#define MUL_TOOM3_THRESHOLD 300
+#endif
+
+#ifndef MUL_TOOM4_THRESHOLD
+#define MUL_TOOM4_THRESHOLD 1000
+#endif
+
+#ifndef MUL_NTT_THRESHOLD
+#define MUL_NTT_THRESHOLD 12000
+#endif
+
+// 平方的 basecase 只算一半的交叉积，比乘法晚切换到 Karatsuba；达到 MUL_TOOM3_THRESHOLD 后与乘法共用 Toom / NTT。
+// 字数很少时移位和对角线的额外开销超过省下的乘法，直接按普通乘法计算
+#ifndef SQR_BASECASE_THRESHOLD
+#define SQR_BASECASE_THRESHOLD 6
+#endif
+
+#ifndef SQR_KARATSUBA_THRESHOLD
+#define SQR_KARATSUBA_THRESHOLD 48
+#endif
+
+// 开启多线程时，不少于该字数的乘法把子乘积分给线程池
+#ifndef MUL_PARALLEL_THRESHOLD
+#define MUL_PARALLEL_THRESHOLD 1500
+#endif
+
+namespace
+{
+    // 规模足够大且开启了多线程时并行执行互不依赖的子乘积，否则依次执行
+    void RunProducts(std::function<void()>* products, size_t count, size_t size)
+    {
+        if (size >= MUL_PARALLEL_THRESHOLD && LimbOps::ParallelEnabled())
+        {
+            LimbOps::ParallelInvoke(products, count);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            products[i]();
+        }
+    }
+
+    // r[offset..rn) += x[0..xn)，进位一直向高位传递（超出 rn 的部分丢弃）
+    void AddAt(Limb* r, size_t rn, size_t offset, const Limb* x, size_t xn)
+    {
+        unsigned char carry = 0;
+        size_t i = 0;
+        for (; i < xn && offset + i < rn; ++i)
+        {
+            r[offset + i] = LimbOps::AddCarry(r[offset + i], x[i], carry);
+        }
+        for (; carry != 0 && offset + i < rn; ++i)
+        {
+            r[offset + i] = LimbOps::AddCarry(r[offset + i], 0, carry);
+        }
+    }
+
+    // r[0..rn) -= x[0..xn)，要求 xn <= rn 且结果非负
+    void SubFrom(Limb* r, size_t rn, const Limb* x, size_t xn)
+    {
+        unsigned char borrow = 0;
+        size_t i = 0;
+        for (; i < xn; ++i)
+        {
+            r[i] = LimbOps::SubBorrow(r[i], x[i], borrow);
+        }
+        for (; borrow != 0 && i < rn; ++i)
+        {
+            r[i] = LimbOps::SubBorrow(r[i], 0, borrow);
+        }
+    }
+
+    // r[0..xn] = x[0..xn) + y[0..yn)，要求 xn >= yn，r 共 xn + 1 个字
+    void AddUneven(Limb* r, const Limb* x, size_t xn, const Limb* y, size_t yn)
+    {
+        unsigned char carry = 0;
+        size_t i = 0;
+        for (; i < yn; ++i)
+        {
+            r[i] = LimbOps::AddCarry(x[i], y[i], carry);
+        }
+        for (; i < xn; ++i)
+        {
+            r[i] = LimbOps::AddCarry(x[i], 0, carry);
+        }
+        r[xn] = carry;
+    }
+
+    // r[0..an+bn) = a * b，逐字的 schoolbook 乘法
+    void MulBasecase(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        r[an] = LimbOps::Mul1(r, a, an, b[0]);
+        for (size_t j = 1; j < bn; ++j)
+        {
+            r[an + j] = LimbOps::AddMul1(r + j, a, an, b[j]);
+        }
+    }
+
+    // a 比 b 长很多时，把 a 按 bn 个字分块，逐块与 b 相乘后累加
+    void MulUnbalanced(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        LimbOps::Mul(r, a, bn, b, bn);
+        std::fill(r + 2 * bn, r + an + bn, 0);
+
+        if (bn >= MUL_PARALLEL_THRESHOLD && LimbOps::ParallelEnabled())
+        {
+            // 并行时每块使用各自的缓冲区，全部算完后再依次累加
+            size_t blocks = (an - 1) / bn;
+            std::vector<std::vector<Limb>> temps(blocks, std::vector<Limb>(2 * bn));
+            std::vector<std::function<void()>> products;
+            for (size_t k = 0; k < blocks; ++k)
+            {
+                size_t offset = (k + 1) * bn;
+                size_t len = std::min(bn, an - offset);
+                Limb* temp = temps[k].data();
+                products.push_back([=] { LimbOps::Mul(temp, a + offset, len, b, bn); });
+            }
+            LimbOps::ParallelInvoke(products.data(), products.size());
+            for (size_t k = 0; k < blocks; ++k)
+            {
+                size_t offset = (k + 1) * bn;
+                AddAt(r, an + bn, offset, temps[k].data(), std::min(bn, an - offset) + bn);
+            }
+            return;
+        }
+
+        std::vector<Limb> temp(2 * bn);
+        for (size_t offset = bn; offset < an; offset += bn)
+        {
+            size_t len = std::min(bn, an - offset);
+            LimbOps::Mul(temp.data(), a + offset, len, b, bn);
+            AddAt(r, an + bn, offset, temp.data(), len + bn);
+        }
+    }
+
+    // r[0..2n) = a^2：i < j 的交叉积 a[i]*a[j] 只算一次，乘2后再加上对角线 a[i]^2
+    void SqrBasecase(Limb* r, const Limb* a, size_t n)
+    {
+        std::fill(r, r + 2 * n, 0);
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            r[n + i] = LimbOps::AddMul1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+        LimbOps::ShiftLeft(r, r, 2 * n, 1);
+
+        unsigned char carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            Limb hi;
+            Limb lo = LimbOps::MulHiLo(a[i], a[i], hi);
+            r[2 * i] = LimbOps::AddCarry(r[2 * i], lo, carry);
+            r[2 * i + 1] = LimbOps::AddCarry(r[2 * i + 1], hi, carry);
+        }
+    }
+
+    // Karatsuba：a = a1*B^h + a0，b = b1*B^h + b0，
+    // a*b = z2*B^2h + ((a0+a1)(b0+b1) - z0 - z2)*B^h + z0
+    void MulKaratsuba(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        size_t h = (an + 1) / 2;
+        size_t a1n = an - h;
+        size_t b1n = bn - h;
+
+        std::vector<Limb> sum(2 * (h + 1));
+        Limb* sa = sum.data();
+        Limb* sb = sa + h + 1;
+        AddUneven(sa, a, h, a + h, a1n);
+        AddUneven(sb, b, h, b + h, b1n);
+
+        // r 的低 2h 个字放 z0，高位放 z2，三个乘积互不依赖
+        std::vector<Limb> z1(2 * (h + 1));
+        std::function<void()> products[] = {
+            [=] { LimbOps::Mul(r, a, h, b, h); },
+            [=] { LimbOps::Mul(r + 2 * h, a + h, a1n, b + h, b1n); },
+            [&] { LimbOps::Mul(z1.data(), sa, h + 1, sb, h + 1); },
+        };
+        RunProducts(products, 3, bn);
+        SubFrom(z1.data(), z1.size(), r, 2 * h);
+        SubFrom(z1.data(), z1.size(), r + 2 * h, a1n + b1n);
+
+        AddAt(r, an + bn, h, z1.data(), LimbOps::Normalized(z1.data(), z1.size()));
+    }
+
+    // Toom-Cook 求值/插值过程中使用的带符号数（符号 + 绝对值）
+    struct ToomValue
+    {
+        std::vector<Limb> Mag;
+        bool Negative = false;
+    };
+
+    void Trim(ToomValue& x)
+    {
+        x.Mag.resize(LimbOps::Normalized(x.Mag.data(), x.Mag.size()));
+        if (x.Mag.empty())
+        {
+            x.Negative = false;
+        }
+    }
+
+    int CompareMag(const std::vector<Limb>& x, const std::vector<Limb>& y)
+    {
+        if (x.size() != y.size())
+        {
+            return x.size() > y.size() ? 1 : -1;
+        }
+        return LimbOps::Compare(x.data(), y.data(), x.size());
+    }
+
+    // x += y（negateY 为 true 时 x -= y）
+    void AddSigned(ToomValue& x, const ToomValue& y, bool negateY)
+    {
+        bool yNegative = y.Negative != negateY;
+        if (y.Mag.empty())
+        {
+            return;
+        }
+
+        if (x.Negative == yNegative)
+        {
+            size_t n = std::max(x.Mag.size(), y.Mag.size());
+            x.Mag.resize(n + 1, 0);
+            AddAt(x.Mag.data(), n + 1, 0, y.Mag.data(), y.Mag.size());
+        }
+        else if (CompareMag(x.Mag, y.Mag) >= 0)
+        {
+            SubFrom(x.Mag.data(), x.Mag.size(), y.Mag.data(), y.Mag.size());
+        }
+        else
+        {
+            std::vector<Limb> diff(y.Mag);
+            SubFrom(diff.data(), diff.size(), x.Mag.data(), x.Mag.size());
+            x.Mag.swap(diff);
+            x.Negative = yNegative;
+        }
+        Trim(x);
+    }
+
+    // x *= k（k 为较小的整数）
+    void MulSmall(ToomValue& x, int64_t k)
+    {
+        if (k < 0)
+        {
+            x.Negative = !x.Negative;
+            k = -k;
+        }
+        Limb carry = LimbOps::Mul1(x.Mag.data(), x.Mag.data(), x.Mag.size(), static_cast<Limb>(k));
+        x.Mag.push_back(carry);
+        Trim(x);
+    }
+
+    // x /= k，要求能够整除。k 的2的幂部分用移位，奇数部分乘以模 2^64 的逆元（不需要做除法指令）
+    void DivExactSmall(ToomValue& x, int64_t k)
+    {
+        if (k < 0)
+        {
+            x.Negative = !x.Negative;
+            k = -k;
+        }
+
+        Limb d = static_cast<Limb>(k);
+        size_t zeros = 0;
+        while ((d & 1) == 0)
+        {
+            d >>= 1;
+            ++zeros;
+        }
+        if (zeros != 0)
+        {
+            LimbOps::ShiftRight(x.Mag.data(), x.Mag.data(), x.Mag.size(), zeros);
+        }
+
+        if (d != 1)
+        {
+            // Newton 迭代求 d 模 2^64 的逆元，每次迭代有效位数翻倍
+            Limb inverse = d;
+            for (int i = 0; i < 5; ++i)
+            {
+                inverse *= 2 - d * inverse;
+            }
+
+            Limb borrow = 0;
+            for (size_t i = 0; i < x.Mag.size(); ++i)
+            {
+                Limb value = x.Mag[i];
+                Limb diff = value - borrow;
+                Limb q = diff * inverse;
+                x.Mag[i] = q;
+
+                Limb hi;
+                LimbOps::MulHiLo(q, d, hi);
+                borrow = hi + (value < borrow);
+            }
+        }
+        Trim(x);
+    }
+
+    ToomValue Product(const ToomValue& x, const ToomValue& y)
+    {
+        ToomValue result;
+        if (x.Mag.empty() || y.Mag.empty())
+        {
+            return result;
+        }
+        result.Mag.resize(x.Mag.size() + y.Mag.size());
+        LimbOps::Mul(result.Mag.data(), x.Mag.data(), x.Mag.size(), y.Mag.data(), y.Mag.size());
+        result.Negative = x.Negative != y.Negative;
+        Trim(result);
+        return result;
+    }
+
+    // 预留一个字给进位，避免之后的加法重新分配
+    ToomValue Copy(const ToomValue& x, size_t otherSize)
+    {
+        ToomValue result;
+        result.Mag.reserve(std::max(x.Mag.size(), otherSize) + 1);
+        result.Mag = x.Mag;
+        result.Negative = x.Negative;
+        return result;
+    }
+
+    ToomValue Sum(const ToomValue& x, const ToomValue& y)
+    {
+        ToomValue result = Copy(x, y.Mag.size());
+        AddSigned(result, y, false);
+        return result;
+    }
+
+    ToomValue Diff(const ToomValue& x, const ToomValue& y)
+    {
+        ToomValue result = Copy(x, y.Mag.size());
+        AddSigned(result, y, true);
+        return result;
+    }
+
+    ToomValue Scaled(const ToomValue& x, int64_t k)
+    {
+        ToomValue result = Copy(x, 0);
+        MulSmall(result, k);
+        return result;
+    }
+
+    // 把 x 的第 i 段（每段 m 个字）取出来
+    ToomValue Piece(const Limb* x, size_t xn, size_t i, size_t m)
+    {
+        ToomValue piece;
+        size_t begin = std::min(i * m, xn);
+        size_t end = std::min(begin + m, xn);
+        piece.Mag.assign(x + begin, x + end);
+        Trim(piece);
+        return piece;
+    }
+
+    // 把各项系数 c[i] 放到 r 的第 i*m 个字处累加，所有系数均为非负数
+    void Recompose(Limb* r, size_t rn, const std::vector<ToomValue>& c, size_t m)
+    {
+        std::fill(r, r + rn, 0);
+        for (size_t i = 0; i < c.size(); ++i)
+        {
+            AddAt(r, rn, i * m, c[i].Mag.data(), c[i].Mag.size());
+        }
+    }
+
+    // Toom-3：各切成3段，在 0, 1, -1, -2, 无穷远 五个点求值，按 Bodrato 的序列插值
+    void MulToom3(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        size_t m = (an + 2) / 3;
+        ToomValue a0 = Piece(a, an, 0, m), a1 = Piece(a, an, 1, m), a2 = Piece(a, an, 2, m);
+        ToomValue b0 = Piece(b, bn, 0, m), b1 = Piece(b, bn, 1, m), b2 = Piece(b, bn, 2, m);
+
+        // p(1) = a0+a1+a2, p(-1) = a0-a1+a2, p(-2) = 2*(p(-1)+a2) - a0
+        ToomValue pa = Sum(a0, a2), pb = Sum(b0, b2);
+        ToomValue pa1 = Sum(pa, a1), pb1 = Sum(pb, b1);
+        ToomValue paM1 = Diff(pa, a1), pbM1 = Diff(pb, b1);
+        ToomValue paM2 = Diff(Scaled(Sum(paM1, a2), 2), a0);
+        ToomValue pbM2 = Diff(Scaled(Sum(pbM1, b2), 2), b0);
+
+        ToomValue r0, r1, rM1, rM2, rInf;
+        std::function<void()> products[] = {
+            [&] { r0 = Product(a0, b0); },
+            [&] { r1 = Product(pa1, pb1); },
+            [&] { rM1 = Product(paM1, pbM1); },
+            [&] { rM2 = Product(paM2, pbM2); },
+            [&] { rInf = Product(a2, b2); },
+        };
+        RunProducts(products, 5, bn);
+
+        ToomValue r3 = Diff(rM2, r1);
+        DivExactSmall(r3, 3);
+        r1 = Diff(r1, rM1);
+        DivExactSmall(r1, 2);
+        ToomValue r2 = Diff(rM1, r0);
+        r3 = Diff(r2, r3);
+        DivExactSmall(r3, 2);
+        AddSigned(r3, Scaled(rInf, 2), false);
+        AddSigned(r2, r1, false);
+        AddSigned(r2, rInf, true);
+        AddSigned(r1, r3, true);
+
+        Recompose(r, an + bn, { r0, r1, r2, r3, rInf }, m);
+    }
+
+    // Toom-4：各切成4段，在 0, 1, -1, 2, -2, 3, 无穷远 七个点求值。
+    // 插值时把乘积拆成偶次项 E(y) 与奇次项 O(y)（r(x) = E(x^2) + x*O(x^2)），分别求解
+    void MulToom4(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        size_t m = (an + 3) / 4;
+        ToomValue a0 = Piece(a, an, 0, m), a1 = Piece(a, an, 1, m), a2 = Piece(a, an, 2, m), a3 = Piece(a, an, 3, m);
+        ToomValue b0 = Piece(b, bn, 0, m), b1 = Piece(b, bn, 1, m), b2 = Piece(b, bn, 2, m), b3 = Piece(b, bn, 3, m);
+
+        // 偶次部分与奇次部分：p(±1) = (a0+a2) ± (a1+a3)，p(±2) = (a0+4a2) ± 2(a1+4a3)
+        ToomValue ea1 = Sum(a0, a2), oa1 = Sum(a1, a3);
+        ToomValue eb1 = Sum(b0, b2), ob1 = Sum(b1, b3);
+        ToomValue ea2 = Sum(a0, Scaled(a2, 4)), oa2 = Scaled(Sum(a1, Scaled(a3, 4)), 2);
+        ToomValue eb2 = Sum(b0, Scaled(b2, 4)), ob2 = Scaled(Sum(b1, Scaled(b3, 4)), 2);
+        // p(3) 用 Horner 法
+        ToomValue pa3 = Sum(Scaled(Sum(Scaled(Sum(Scaled(a3, 3), a2), 3), a1), 3), a0);
+        ToomValue pb3 = Sum(Scaled(Sum(Scaled(Sum(Scaled(b3, 3), b2), 3), b1), 3), b0);
+
+        ToomValue c0, r1, rM1, r2, rM2, r3, c6;
+        std::function<void()> products[] = {
+            [&] { c0 = Product(a0, b0); },
+            [&] { r1 = Product(Sum(ea1, oa1), Sum(eb1, ob1)); },
+            [&] { rM1 = Product(Diff(ea1, oa1), Diff(eb1, ob1)); },
+            [&] { r2 = Product(Sum(ea2, oa2), Sum(eb2, ob2)); },
+            [&] { rM2 = Product(Diff(ea2, oa2), Diff(eb2, ob2)); },
+            [&] { r3 = Product(pa3, pb3); },
+            [&] { c6 = Product(a3, b3); },
+        };
+        RunProducts(products, 7, bn);
+
+        // E(1) = c0+c2+c4+c6，E(4) = c0+4c2+16c4+64c6
+        ToomValue e1 = Sum(r1, rM1);
+        DivExactSmall(e1, 2);
+        ToomValue e4 = Sum(r2, rM2);
+        DivExactSmall(e4, 2);
+        AddSigned(e1, c0, true);
+        AddSigned(e1, c6, true);
+        AddSigned(e4, c0, true);
+        AddSigned(e4, Scaled(c6, 64), true);
+        ToomValue c4 = Diff(e4, Scaled(e1, 4));
+        DivExactSmall(c4, 12);
+        ToomValue c2 = Diff(e1, c4);
+
+        // O(1) = c1+c3+c5，O(4) = c1+4c3+16c5，O(9) = c1+9c3+81c5
+        ToomValue o1 = Diff(r1, rM1);
+        DivExactSmall(o1, 2);
+        ToomValue o4 = Diff(r2, rM2);
+        DivExactSmall(o4, 4);
+        ToomValue o9 = r3;
+        AddSigned(o9, c0, true);
+        AddSigned(o9, Scaled(c2, 9), true);
+        AddSigned(o9, Scaled(c4, 81), true);
+        AddSigned(o9, Scaled(c6, 729), true);
+        DivExactSmall(o9, 3);
+
+        // 对 O(y) 在 y = 1, 4, 9 处做差商
+        ToomValue d1 = Diff(o4, o1);
+        DivExactSmall(d1, 3);
+        ToomValue d2 = Diff(o9, o4);
+        DivExactSmall(d2, 5);
+        ToomValue c5 = Diff(d2, d1);
+        DivExactSmall(c5, 8);
+        ToomValue c3 = Diff(d1, Scaled(c5, 5));
+        ToomValue c1 = Diff(Diff(o1, c3), c5);
+
+        Recompose(r, an + bn, { c0, c1, c2, c3, c4, c5, c6 }, m);
+    }
+
+    // 要求 an >= bn >= 1，且 a、b 最高字非0
+    void MulTrimmed(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+    {
+        if (bn < MUL_KARATSUBA_THRESHOLD)
+        {
+            INSTRUMENT_COUNT(Instrument::Op::MulBasecase, an);
+            MulBasecase(r, a, an, b, bn);
+        }
+        else if (bn >= MUL_NTT_THRESHOLD)
+        {
+            INSTRUMENT_COUNT(Instrument::Op::MulNtt, an);
+            LimbOps::MulNtt(r, a, an, b, bn);
+        }
+        else if (an >= 2 * bn - bn / 4)
+        {
+            // 长度相差太大时，切块后 Karatsuba 的 b1 会过短甚至为空
+            INSTRUMENT_COUNT(Instrument::Op::MulUnbalanced, an);
+            MulUnbalanced(r, a, an, b, bn);
+        }
+        else if (bn >= MUL_TOOM4_THRESHOLD)
+        {
+            INSTRUMENT_COUNT(Instrument::Op::MulToom4, an);
+            MulToom4(r, a, an, b, bn);
+        }
+        else if (bn >= MUL_TOOM3_THRESHOLD)
+        {
+            INSTRUMENT_COUNT(Instrument::Op::MulToom3, an);
+            MulToom3(r, a, an, b, bn);
+        }
+        else
+        {
+            INSTRUMENT_COUNT(Instrument::Op::MulKaratsuba, an);
+            MulKaratsuba(r, a, an, b, bn);
+        }
+    }
+
+    // 平方的 Karatsuba：a = a1*B^h + a0，a^2 = z2*B^2h + (z0 + z2 - (a0-a1)^2)*B^h + z0，
+    // 用差的平方代替和的平方，中间项不会多出一个字
+    void SqrKaratsuba(Limb* r, const Limb* a, size_t n)
+    {
+        size_t h = (n + 1) / 2;
+        size_t a1n = n - h;
+
+        std::vector<Limb> diff(h, 0);
+        std::copy(a + h, a + n, diff.begin());
+        if (LimbOps::Compare(a, diff.data(), h) >= 0)
+        {
+            LimbOps::Sub(diff.data(), a, diff.data(), h);
+        }
+        else
+        {
+            LimbOps::Sub(diff.data(), diff.data(), a, h);
+        }
+
+        std::vector<Limb> z1(2 * h);
+        std::function<void()> products[] = {
+            [=] { LimbOps::Sqr(r, a, h); },
+            [=] { LimbOps::Sqr(r + 2 * h, a + h, a1n); },
+            [&] { LimbOps::Sqr(z1.data(), diff.data(), h); },
+        };
+        RunProducts(products, 3, n);
+
+        std::vector<Limb> middle(2 * h + 1, 0);
+        std::copy(r, r + 2 * h, middle.begin());
+        AddAt(middle.data(), middle.size(), 0, r + 2 * h, 2 * a1n);
+        SubFrom(middle.data(), middle.size(), z1.data(), z1.size());
+        AddAt(r, 2 * n, h, middle.data(), LimbOps::Normalized(middle.data(), middle.size()));
+    }
+}
+
+void LimbOps::Sqr(Limb* r, const Limb* a, size_t n)
+{
+    size_t at = Normalized(a, n);
+    std::fill(r + 2 * at, r + 2 * n, 0);
+    if (at == 0)
+    {
+        return;
+    }
+
+    if (at < SQR_BASECASE_THRESHOLD)
+    {
+        INSTRUMENT_COUNT(Instrument::Op::MulBasecase, at);
+        MulBasecase(r, a, at, a, at);
+    }
+    else if (at < SQR_KARATSUBA_THRESHOLD)
+    {
+        INSTRUMENT_COUNT(Instrument::Op::MulBasecase, at);
+        SqrBasecase(r, a, at);
+    }
+    else if (at < MUL_TOOM3_THRESHOLD)
+    {
+        INSTRUMENT_COUNT(Instrument::Op::MulKaratsuba, at);
+        SqrKaratsuba(r, a, at);
+    }
+    else
+    {
+        MulTrimmed(r, a, at, a, at);
+    }
+}
+
+void LimbOps::Mul(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+{
+    // 去掉高位的0字，结果中多出的高位直接清零
+    size_t at = Normalized(a, an);
+    size_t bt = Normalized(b, bn);
+    if (at == 0 || bt == 0)
+    {
+        std::fill(r, r + an + bn, 0);
+        return;
+    }
+    std::fill(r + at + bt, r + an + bn, 0);
+
+    if (at < bt)
+    {
+        std::swap(a, b);
+        std::swap(at, bt);
+    }
+    MulTrimmed(r, a, at, b, bt);
+}
+
+void LimbOps::MulLow(Limb* r, const Limb* a, const Limb* b, size_t n)
+{
+    size_t at = Normalized(a, n);
+    size_t bt = Normalized(b, n);
+    if (at == 0 || bt == 0)
+    {
+        std::fill(r, r + n, 0);
+        return;
+    }
+
+    // 完整乘积不超过 n 个字，或者有一个操作数很短时，直接算完整乘积
+    if (at + bt <= n || std::min(at, bt) < MUL_KARATSUBA_THRESHOLD)
+    {
+        if (at + bt <= n)
+        {
+            Mul(r, a, at, b, bt);
+            std::fill(r + at + bt, r + n, 0);
+            return;
+        }
+
+        // 短乘积的 basecase：只计算落在低 n 个字里的部分积
+        if (at < bt)
+        {
+            std::swap(a, b);
+            std::swap(at, bt);
+        }
+        std::fill(r, r + n, 0);
+        for (size_t j = 0; j < bt && j < n; ++j)
+        {
+            size_t len = std::min(at, n - j);
+            Limb carry = LimbOps::AddMul1(r + j, a, len, b[j]);
+            AddAt(r, n, j + len, &carry, 1);
+        }
+        return;
+    }
+
+    // NTT 的代价只与变换长度有关，拆成三次乘法反而更慢，直接算完整乘积
+    if (std::min(at, bt) >= MUL_NTT_THRESHOLD)
+    {
+        std::vector<Limb> full(at + bt);
+        Mul(full.data(), a, at, b, bt);
+        std::copy(full.begin(), full.begin() + n, r);
+        return;
+    }
+
+    // a = a1*B^h + a0，b = b1*B^h + b0，低 n 个字 = a0*b0 + (a1*b0 + a0*b1)*B^h
+    size_t h = (n + 1) / 2;
+    size_t l = n - h;
+    std::vector<Limb> full(2 * h);
+    Mul(full.data(), a, h, b, h);
+    std::copy(full.begin(), full.begin() + n, r);
+
+    std::vector<Limb> cross(l);
+    MulLow(cross.data(), a + h, b, l);
+    LimbOps::Add(r + h, r + h, cross.data(), l);
+    MulLow(cross.data(), a, b + h, l);
+    LimbOps::Add(r + h, r + h, cross.data(), l);
+}
+
+void LimbOps::SignedMulLow(Limb* r, const Limb* a, const Limb* b, size_t BitSize)
+{
+    size_t n = LimbCount(BitSize);
+    if (n == 0)
+    {
+        return;
+    }
+
+    // 补码的截断乘积等于绝对值之积再修正符号，用绝对值可以让较小的负数也去掉高位的0字
+    TempLimbs x(n), y(n), product(n);
+    bool negative = Magnitude(x.data(), a, BitSize) != Magnitude(y.data(), b, BitSize);
+
+    MulLow(product.data(), x.data(), y.data(), n);
+    if (negative)
+    {
+        Negate(product.data(), product.data(), n);
+    }
+
+    std::copy(product.data(), product.data() + n, r);
+    r[n - 1] &= TopMask(BitSize);
+}
@@ -0,0 +1,244 @@
+#include "LimbOps.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// 三素数数论变换（NTT）乘法：把操作数按32位切成系数，在三个形如 c*2^k+1 的素数下分别做卷积，
+// 再用中国剩余定理（Garner 算法）还原每个系数。三个素数之积约为 2^90.5，
+// 足以容纳 2^26 个 32 位系数卷积的最大值 2^26 * (2^32-1)^2
+
+namespace
+{
+    typedef std::uint32_t Coef;
+
+    // -p^(-1) mod 2^32，Newton 迭代每次有效位数翻倍
+    constexpr Coef NegInverseOf(Coef p)
+    {
+        Coef inverse = p;
+        for (int i = 0; i < 4; ++i)
+        {
+            inverse *= 2 - p * inverse;
+        }
+        return static_cast<Coef>(0) - inverse;
+    }
+
+    template <Coef P, Coef G>
+    struct NttPrime
+    {
+        static const Coef Modulus = P;
+        static constexpr Coef NegInverse = NegInverseOf(P);
+
+        static Coef MulMod(Coef a, Coef b)
+        {
+            return static_cast<Coef>(static_cast<std::uint64_t>(a) * b % P);
+        }
+
+        static Coef AddMod(Coef a, Coef b)
+        {
+            Coef s = a + b;
+            return s >= P ? s - P : s;
+        }
+
+        static Coef SubMod(Coef a, Coef b)
+        {
+            return a >= b ? a - b : a + P - b;
+        }
+
+        static Coef PowMod(Coef a, std::uint64_t e)
+        {
+            Coef result = 1;
+            while (e != 0)
+            {
+                if (e & 1)
+                {
+                    result = MulMod(result, a);
+                }
+                a = MulMod(a, a);
+                e >>= 1;
+            }
+            return result;
+        }
+
+        // Montgomery 乘法（R = 2^32）：返回 a * b / R mod P。
+        // 单位根以 Montgomery 形式（w*R mod P）保存，与普通形式的系数相乘后正好得到普通形式的 a*w，
+        // 这样蝶形运算中不需要除法
+        static Coef MontMul(Coef a, Coef b)
+        {
+            std::uint64_t t = static_cast<std::uint64_t>(a) * b;
+            Coef m = static_cast<Coef>(t) * NegInverse;
+            Coef result = static_cast<Coef>((t + static_cast<std::uint64_t>(m) * P) >> 32);
+            return result >= P ? result - P : result;
+        }
+
+        static Coef ToMont(Coef a)
+        {
+            return static_cast<Coef>((static_cast<std::uint64_t>(a) << 32) % P);
+        }
+
+        // 按频率抽取（DIF）的正变换，输入为自然顺序，输出为位反转顺序。
+        // roots[len + j] 为 2*len 次单位根的 j 次幂
+        static void Forward(Coef* a, size_t n, const std::vector<Coef>& roots)
+        {
+            for (size_t len = n / 2; len >= 1; len /= 2)
+            {
+                const Coef* w = roots.data() + len;
+                for (size_t i = 0; i < n; i += 2 * len)
+                {
+                    for (size_t j = 0; j < len; ++j)
+                    {
+                        Coef u = a[i + j];
+                        Coef v = a[i + j + len];
+                        a[i + j] = AddMod(u, v);
+                        a[i + j + len] = MontMul(SubMod(u, v), w[j]);
+                    }
+                }
+            }
+        }
+
+        // 按时间抽取（DIT）的逆变换，输入为位反转顺序，输出为自然顺序（未乘 1/n）
+        static void Inverse(Coef* a, size_t n, const std::vector<Coef>& roots)
+        {
+            for (size_t len = 1; len < n; len *= 2)
+            {
+                const Coef* w = roots.data() + len;
+                for (size_t i = 0; i < n; i += 2 * len)
+                {
+                    for (size_t j = 0; j < len; ++j)
+                    {
+                        Coef u = a[i + j];
+                        Coef v = MontMul(a[i + j + len], w[j]);
+                        a[i + j] = AddMod(u, v);
+                        a[i + j + len] = SubMod(u, v);
+                    }
+                }
+            }
+        }
+
+        // 在该素数下计算 x、y 的循环卷积，结果写回 x
+        static void Convolve(std::vector<Coef>& x, std::vector<Coef>& y, size_t n)
+        {
+            std::vector<Coef> forwardRoots(n), inverseRoots(n);
+            for (size_t len = 1; len < n; len *= 2)
+            {
+                FillRoots(forwardRoots.data() + len, len, PowMod(G, (P - 1) / (2 * len)));
+                FillRoots(inverseRoots.data() + len, len, PowMod(G, (P - 1) - (P - 1) / (2 * len)));
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                x[i] %= P;
+                y[i] %= P;
+            }
+            Forward(x.data(), n, forwardRoots);
+            Forward(y.data(), n, forwardRoots);
+
+            // 逐点相乘时多出的 1/R 与最后的 1/n 合并成一次缩放
+            for (size_t i = 0; i < n; ++i)
+            {
+                x[i] = MontMul(x[i], y[i]);
+            }
+            Inverse(x.data(), n, inverseRoots);
+
+            Coef scale = ToMont(ToMont(PowMod(static_cast<Coef>(n % P), P - 2)));
+            for (size_t i = 0; i < n; ++i)
+            {
+                x[i] = MontMul(x[i], scale);
+            }
+        }
+
+    private:
+        static void FillRoots(Coef* roots, size_t len, Coef w)
+        {
+            Coef power = 1;
+            for (size_t j = 0; j < len; ++j)
+            {
+                roots[j] = ToMont(power);
+                power = MulMod(power, w);
+            }
+        }
+    };
+
+    typedef NttPrime<469762049, 3> Prime1;     // 7 * 2^26 + 1
+    typedef NttPrime<1811939329, 13> Prime2;   // 27 * 2^26 + 1
+    typedef NttPrime<2013265921, 31> Prime3;   // 15 * 2^27 + 1
+
+    const size_t MaxTransformLength = size_t(1) << 26;
+
+    // 把 n 个字拆成 32 位系数，放入长度为 length 的数组（多余部分补0）
+    std::vector<Coef> Split(const Limb* a, size_t n, size_t length)
+    {
+        std::vector<Coef> coefs(length, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            coefs[2 * i] = static_cast<Coef>(a[i]);
+            coefs[2 * i + 1] = static_cast<Coef>(a[i] >> 32);
+        }
+        return coefs;
+    }
+}
+
+void LimbOps::MulNtt(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn)
+{
+    size_t resultCoefs = 2 * (an + bn);
+    size_t length = 1;
+    while (length < resultCoefs)
+    {
+        length *= 2;
+    }
+    if (length > MaxTransformLength)
+    {
+        throw std::length_error("Operands too large for NTT multiplication");
+    }
+
+    std::vector<Coef> a1 = Split(a, an, length), b1 = Split(b, bn, length);
+    std::vector<Coef> a2(a1), b2(b1), a3(a1), b3(b1);
+    // 三个素数下的卷积互不依赖，开启多线程时并行计算
+    std::function<void()> convolutions[] = {
+        [&] { Prime1::Convolve(a1, b1, length); },
+        [&] { Prime2::Convolve(a2, b2, length); },
+        [&] { Prime3::Convolve(a3, b3, length); },
+    };
+    ParallelInvoke(convolutions, 3);
+
+    // Garner：x = r1 + p1*k1 + p1*p2*k2
+    const Coef p1 = Prime1::Modulus;
+    const Coef p2 = Prime2::Modulus;
+    const std::uint64_t p1p2 = static_cast<std::uint64_t>(p1) * p2;
+    const Coef p1InvModP2 = Prime2::PowMod(p1 % Prime2::Modulus, Prime2::Modulus - 2);
+    const Coef p1p2InvModP3 = Prime3::PowMod(static_cast<Coef>(p1p2 % Prime3::Modulus), Prime3::Modulus - 2);
+
+    // 128 位累加器，每个系数落在 32*i 位处，每一步输出低 32 位
+    Limb accLo = 0, accHi = 0;
+    size_t total = an + bn;
+    for (size_t i = 0; i < 2 * total; ++i)
+    {
+        Coef r1 = a1[i], r2 = a2[i], r3 = a3[i];
+        Coef k1 = Prime2::MulMod(Prime2::SubMod(r2 % Prime2::Modulus, r1 % Prime2::Modulus), p1InvModP2);
+        std::uint64_t t = r1 + static_cast<std::uint64_t>(p1) * k1;
+        Coef k2 = Prime3::MulMod(Prime3::SubMod(r3, static_cast<Coef>(t % Prime3::Modulus)), p1p2InvModP3);
+
+        Limb xHi;
+        Limb xLo = MulHiLo(p1p2, k2, xHi);
+        unsigned char carry = 0;
+        xLo = AddCarry(xLo, t, carry);
+        xHi += carry;
+
+        carry = 0;
+        accLo = AddCarry(accLo, xLo, carry);
+        accHi = accHi + xHi + carry;
+
+        Coef out = static_cast<Coef>(accLo);
+        if (i % 2 == 0)
+        {
+            r[i / 2] = out;
+        }
+        else
+        {
+            r[i / 2] |= static_cast<Limb>(out) << 32;
+        }
+        accLo = (accLo >> 32) | (accHi << 32);
+        accHi >>= 32;
+    }
+}
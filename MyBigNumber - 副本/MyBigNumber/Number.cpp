@@ -1,653 +1,860 @@
-#include "Number.h"
-#include <stdexcept>
-#include <cstdlib>
-#include <iostream>
-
-Number::Number(size_t BitSize):NumberType(Undefine)
-{
-    this->BitSize = BitSize;
-    // DataԪظ
-    size_t NeedGroup = (BitSize + 7) / 8;
-
-    // ڴ
-    Data = static_cast<unsigned char*>(malloc(NeedGroup));
-    Invalid = static_cast<unsigned char*>(malloc(NeedGroup));
-
-    // ڴǷɹ
-    if (Data == nullptr || Invalid == nullptr)
-    {
-        // ͷѷڴ
-        free(Data);
-        free(Invalid);
-        throw std::bad_alloc();
-    }
-
-    // ʼDataInvalid
-    std::fill_n(Data, NeedGroup, 0);
-    std::fill_n(Invalid, NeedGroup, 0xFF);  // 0xFFʾЧ
-}
-
-Number::Number(const Number& other) :NumberType(Undefine)
-{
-    BitSize = other.BitSize;  // λС
-    size_t NeedGroup = (BitSize + 7) / 8;  // Ҫֽ
-
-    // ڴDataInvalid
-    Data = static_cast<unsigned char*>(malloc(NeedGroup));
-    Invalid = static_cast<unsigned char*>(malloc(NeedGroup));
-
-    // ڴǷɹ
-    if (Data == nullptr || Invalid == nullptr)
-    {
-        free(Data);  // ͷѷڴ
-        free(Invalid);
-        throw std::bad_alloc();  // ׳ڴʧ쳣
-    }
-
-    // otherDataInvalidݵ¶
-    std::copy(other.Data, other.Data + NeedGroup, Data);
-    std::copy(other.Invalid, other.Invalid + NeedGroup, Invalid);
-}
-
-Number& Number::operator=(const Number& other)
-{
-    if (this == &other)  // Ըֵ
-    {
-        return *this;
-    }
-
-    free(Data);  // ͷŵǰDataڴ
-    free(Invalid);  // ͷŵǰInvalidڴ
-
-    BitSize = other.BitSize;  // λС
-    size_t NeedGroup = (BitSize + 7) / 8;  // Ҫֽ
-
-    // ڴDataInvalid
-    Data = static_cast<unsigned char*>(malloc(NeedGroup));
-    Invalid = static_cast<unsigned char*>(malloc(NeedGroup));
-
-    // ڴǷɹ
-    if (Data == nullptr || Invalid == nullptr)
-    {
-        free(Data);  // ͷѷڴ
-        free(Invalid);
-        throw std::bad_alloc();  // ׳ڴʧ쳣
-    }
-
-    // otherDataInvalidݵǰ
-    std::copy(other.Data, other.Data + NeedGroup, Data);
-    std::copy(other.Invalid, other.Invalid + NeedGroup, Invalid);
-
-    return *this;  // صǰ֧ʽֵ
-}
-
-void Number::SetBit(size_t BitIndex)
-{
-    //  BitIndex Ƿ񳬳Χ
-    if (BitIndex >= BitSize)
-    {
-        throw std::out_of_range("Bit index out of range");
-    }
-
-    size_t GroupSize = (BitSize + 7) / 8 - 1;
-
-    // ֽλλ
-    size_t operatorgroup = (BitIndex / 8); // ֽҵ
-    size_t bitPosition = BitIndex % 8; // λλãҵ
-
-    // ضλ
-    Data[GroupSize-operatorgroup] |= (1 << bitPosition);
-}
-
-void Number::ClearBit(size_t BitIndex)
-{
-    //  BitIndex Ƿ񳬳Χ
-    if (BitIndex >= BitSize)
-    {
-        throw std::out_of_range("Bit index out of range");
-    }
-
-    size_t GroupSize = (BitSize + 7) / 8 - 1;
-
-    // ֽλλ
-    size_t operatorgroup = (BitIndex / 8); // ֽҵ
-    size_t bitPosition = BitIndex % 8; // λλãҵ
-
-    // ضλ
-    Data[GroupSize - operatorgroup] &= ~(1 << bitPosition);
-}
-
-void Number::ToggleBit(size_t BitIndex)
-{
-    //  BitIndex Ƿ񳬳Χ
-    if (BitIndex >= BitSize)
-    {
-        throw std::out_of_range("Bit index out of range");
-    }
-
-    size_t GroupSize = (BitSize + 7) / 8 - 1;
-
-    // ֽλλ
-    size_t operatorgroup = (BitIndex / 8); // ֽҵ
-    size_t bitPosition = BitIndex % 8; // λλãҵ
-
-    // лضλ
-    Data[GroupSize - operatorgroup] ^= (1 << bitPosition);
-}
-
-size_t Number::GetBitSize()const
-{
-    return BitSize;
-}
-
-int Number::GetBit(size_t BitIndex) const
-{
-    if (BitIndex >= BitSize) throw std::out_of_range("BitIndex out of range");
-    size_t GroupSize = (BitSize + 7) / 8 - 1;
-
-    // ֽλλ
-    size_t operatorgroup = (BitIndex / 8); // ֽҵ
-    size_t bitPosition = BitIndex % 8; // λλãҵ
-
-    return (Data[GroupSize - operatorgroup] & (1 << bitPosition)) != 0;
-}
-
-void Number::ToNegative()
-{
-    if (NumberType == Type::Integer)
-    {
-        // ʹòʾ
-        // Invert all bits
-        for (size_t i = 0; i < BitSize; ++i)
-        {
-            ToggleBit(i);
-        }
-
-        // Add 1 to the least significant bit
-        bool carry = true;
-        for (size_t i = 0; i < BitSize && carry; ++i)
-        {
-            if (GetBit(i) == 0)
-            {
-                SetBit(i);
-                carry = false;
-            }
-            else
-            {
-                ClearBit(i);
-            }
-        }
-    }
-    else if (NumberType == Type::FloatIngpoint)
-    {
-        // ȡλ
-        InvertSignBit();
-    }
-    else
-    {
-        throw std::runtime_error("Undefined number type");
-    }
-}
-
-const unsigned char* Number::GetData()const
-{
-    return Data;
-}
-
-Number::Type Number::GetType()
-{
-    return NumberType;
-}
-
-void Number::InvertSignBit()
-{
-    // 踡ķλλ
-    ToggleBit(BitSize - 1);
-}
-
-//void Number::add(const Number& other, bool subtract)
-//{
-//    if (BitSize != other.BitSize)
-//    {
-//        throw std::invalid_argument("Bit sizes do not match");
-//    }
-//
-//    size_t NeedGroup = (BitSize + 7) / 8;
-//    unsigned carry = subtract ? 1 : 0;  // If subtracting, start with carry as 1 to handle two's complement
-//    unsigned char* tempData = static_cast<unsigned char*>(malloc(NeedGroup));
-//
-//    if (tempData == nullptr)
-//    {
-//        throw std::bad_alloc();
-//    }
-//
-//    for (size_t i = 0; i < NeedGroup; ++i)
-//    {
-//        unsigned temp1 = Data[i];
-//        unsigned temp2 = other.Data[i];
-//
-//        if (subtract)
-//        {
-//            temp2 = ~temp2;
-//        }
-//
-//        unsigned sum = temp1 + temp2 + carry;
-//        carry = (sum > 0xFF) ? 1 : 0;
-//        tempData[i] = sum & 0xFF;
-//    }
-//
-//    std::copy(tempData, tempData + NeedGroup, Data);
-//    free(tempData);
-//
-//    if (subtract)
-//    {
-//        bool carry = true;
-//        for (size_t i = 0; i < BitSize && carry; ++i)
-//        {
-//            if (GetBit(i) == 0)
-//            {
-//                SetBit(i);
-//                carry = false;
-//            }
-//            else
-//            {
-//                ClearBit(i);
-//            }
-//        }
-//    }
-//}
-//
-//void Number::multiply(const Number& other)
-//{
-//    if (BitSize != other.BitSize)
-//    {
-//        throw std::invalid_argument("Bit sizes do not match");
-//    }
-//
-//    Number result(BitSize);
-//    Number temp(*this);
-//
-//    for (size_t i = 0; i < BitSize; ++i)
-//    {
-//        if (other.GetBit(i))
-//        {
-//            result += temp;
-//        }
-//        temp <<= 1;
-//    }
-//
-//    std::copy(result.Data, result.Data + (BitSize + 7) / 8, Data);
-//}
-//
-//void Number::divide(const Number& other)
-//{
-//    if (BitSize != other.BitSize)
-//    {
-//        throw std::invalid_argument("Bit sizes do not match");
-//    }
-//
-//    Number dividend(*this);
-//    Number divisor(other);
-//    Number quotient(BitSize);
-//    Number one(BitSize);
-//
-//    one.SetBit(0);
-//
-//    for (size_t i = BitSize; i > 0; --i)
-//    {
-//        quotient <<= 1;
-//        if (dividend >= divisor)
-//        {
-//            dividend -= divisor;
-//            quotient |= one;
-//        }
-//        divisor >>= 1;
-//    }
-//
-//    std::copy(quotient.Data, quotient.Data + (BitSize + 7) / 8, Data);
-//}
-
-Number& Number::operator&=(const Number& other)
-{
-    if (BitSize != other.BitSize)
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    size_t NeedGroup = (BitSize + 7) / 8;
-    for (size_t i = 0; i < NeedGroup; ++i)
-    {
-        Data[i] &= other.Data[i];
-    }
-
-    return *this;
-}
-
-Number& Number::operator|=(const Number& other)
-{
-    if (BitSize != other.BitSize)
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    size_t NeedGroup = (BitSize + 7) / 8;
-    for (size_t i = 0; i < NeedGroup; ++i)
-    {
-        Data[i] |= other.Data[i];
-    }
-
-    return *this;
-}
-
-Number& Number::operator^=(const Number& other)
-{
-    if (BitSize != other.BitSize)
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    size_t NeedGroup = (BitSize + 7) / 8;
-    for (size_t i = 0; i < NeedGroup; ++i)
-    {
-        Data[i] ^= other.Data[i];
-    }
-
-    return *this;
-}
-
-Number& Number::operator<<=(size_t shift)
-{
-    if (shift >= BitSize)
-    {
-        std::fill_n(Data, (BitSize + 7) / 8, 0);
-        return *this;
-    }
-
-    size_t byteShift = shift / 8;
-    size_t bitShift = shift % 8;
-
-    if (bitShift == 0)
-    {
-        std::memmove(Data, Data + byteShift, (BitSize + 7) / 8 - byteShift);
-        std::fill_n(Data + (BitSize + 7) / 8 - byteShift, byteShift, 0);
-    }
-    else
-    {
-        for (size_t i = (BitSize + 7) / 8; i > byteShift; --i)
-        {
-            Data[i - 1] = (Data[i - 1 - byteShift] << bitShift) |
-                (Data[i - 2 - byteShift] >> (8 - bitShift));
-        }
-        Data[byteShift] = Data[0] << bitShift;
-        std::fill_n(Data, byteShift, 0);
-    }
-
-    return *this;
-}
-
-Number& Number::operator>>=(size_t shift)
-{
-    if (shift >= BitSize)
-    {
-        std::fill_n(Data, (BitSize + 7) / 8, 0);
-        return *this;
-    }
-
-    size_t byteShift = shift / 8;
-    size_t bitShift = shift % 8;
-
-    if (bitShift == 0)
-    {
-        std::memmove(Data, Data + byteShift, (BitSize + 7) / 8 - byteShift);
-        std::fill_n(Data + (BitSize + 7) / 8 - byteShift, byteShift, 0);
-    }
-    else
-    {
-        for (size_t i = 0; i < (BitSize + 7) / 8 - byteShift - 1; ++i)
-        {
-            Data[i] = (Data[i + byteShift] >> bitShift) |
-                (Data[i + byteShift + 1] << (8 - bitShift));
-        }
-        Data[(BitSize + 7) / 8 - byteShift - 1] = Data[(BitSize + 7) / 8 - 1] >> bitShift;
-        std::fill_n(Data + (BitSize + 7) / 8 - byteShift, byteShift, 0);
-    }
-
-    return *this;
-}
-
-Number Number::operator~() const
-{
-    Number result(BitSize);
-    size_t NeedGroup = (BitSize + 7) / 8;
-    for (size_t i = 0; i < NeedGroup; ++i)
-    {
-        result.Data[i] = ~Data[i];
-    }
-    return result;
-}
-
-Number Number::operator<<(size_t shift) const
-{
-    Number result = *this;
-    result <<= shift;
-    return result;
-}
-
-Number Number::operator>>(size_t shift) const
-{
-    Number result = *this;
-    result >>= shift;
-    return result;
-}
-
-Number::~Number()
-{
-    if (Data != nullptr) {
-        std::free(Data);
-        Data = nullptr;
-    }
-
-    if (Invalid != nullptr) {
-        std::free(Invalid);
-        Invalid = nullptr;
-    }
-}
-
-Number& Number::operator+=(const Number& other)
-{
-    add(other, false);
-    return *this;
-}
-
-Number& Number::operator-=(const Number& other)
-{
-    add(other, true);
-    return *this;
-}
-
-Number& Number::operator*=(const Number& other)
-{
-    multiply(other);
-    return *this;
-}
-
-Number& Number::operator/=(const Number& other)
-{
-    divide(other);
-    return *this;
-}
-
-Number Number::operator+(const Number& other) const
-{
-    Number result(*this);
-    result += other;
-    return result;
-}
-
-Number Number::operator-(const Number& other) const
-{
-    Number result(*this);
-    result -= other;
-    return result;
-}
-
-Number Number::operator*(const Number& other) const
-{
-    Number result(*this);
-    result *= other;
-    return result;
-}
-
-Number Number::operator/(const Number& other) const
-{
-    Number result(*this);
-    result /= other;
-    return result;
-}
-
-// Helper function to check if a number is negative
-bool isNegative(const Number& num)
-{
-    return num.GetBit(num.GetBitSize() - 1) == 1;
-}
-
-bool Number::operator>=(const Number& other) const
-{
-    if (GetBitSize() != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    bool thisNegative = isNegative(*this);
-    bool otherNegative = isNegative(other);
-
-    if (thisNegative != otherNegative)
-    {
-        return otherNegative;
-    }
-
-    for (size_t i = GetBitSize(); i > 0; --i)
-    {
-        size_t index = i - 1;
-        if (GetBit(index) != other.GetBit(index))
-        {
-            if (thisNegative)
-            {
-                return GetBit(index) < other.GetBit(index);
-            }
-            else
-            {
-                return GetBit(index) > other.GetBit(index);
-            }
-        }
-    }
-
-    return true;
-}
-
-bool Number::operator<=(const Number& other) const
-{
-    if (GetBitSize() != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    bool thisNegative = isNegative(*this);
-    bool otherNegative = isNegative(other);
-
-    if (thisNegative != otherNegative)
-    {
-        return thisNegative;
-    }
-
-    for (size_t i = GetBitSize(); i > 0; --i)
-    {
-        size_t index = i - 1;
-        if (GetBit(index) != other.GetBit(index))
-        {
-            if (thisNegative)
-            {
-                return GetBit(index) > other.GetBit(index);
-            }
-            else
-            {
-                return GetBit(index) < other.GetBit(index);
-            }
-        }
-    }
-
-    return true;
-}
-
-bool Number::operator>(const Number& other) const
-{
-    if (GetBitSize() != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    bool thisNegative = isNegative(*this);
-    bool otherNegative = isNegative(other);
-
-    if (thisNegative != otherNegative)
-    {
-        return otherNegative;
-    }
-
-    for (size_t i = GetBitSize(); i > 0; --i)
-    {
-        size_t index = i - 1;
-        if (GetBit(index) != other.GetBit(index))
-        {
-            if (thisNegative)
-            {
-                return GetBit(index) < other.GetBit(index);
-            }
-            else
-            {
-                return GetBit(index) > other.GetBit(index);
-            }
-        }
-    }
-
-    return false;
-}
-
-bool Number::operator<(const Number& other) const
-{
-    if (GetBitSize() != other.GetBitSize())
-    {
-        throw std::invalid_argument("Bit sizes do not match");
-    }
-
-    bool thisNegative = isNegative(*this);
-    bool otherNegative = isNegative(other);
-
-    if (thisNegative != otherNegative)
-    {
-        return thisNegative;
-    }
-
-    for (size_t i = GetBitSize(); i > 0; --i)
-    {
-        size_t index = i - 1;
-        if (GetBit(index) != other.GetBit(index))
-        {
-            if (thisNegative)
-            {
-                return GetBit(index) > other.GetBit(index);
-            }
-            else
-            {
-                return GetBit(index) < other.GetBit(index);
-            }
-        }
-    }
-
-    return false;
-}
-
-void Number::checkBitIndex(size_t BitIndex) const
-{
-    if (BitIndex >= BitSize) throw std::out_of_range("BitIndex out of range");
-}
\ No newline at end of file
+#include "Number.h"
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <utility>
+
+Number::Number(size_t BitSize):NumberType(Undefine)
+{
+    this->BitSize = BitSize;
+    // 计算Data所需的字（64位）个数
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+
+    // 分配内存（不超过 InlineLimbs 个字时使用对象内的缓冲区）
+    AllocateStorage(NeedGroup);
+
+    // 初始化Data，新建的数所有位都无效，写入数值后才变为有效
+    std::fill_n(Data, NeedGroup, 0);
+    MarkInvalidFrom(0);
+}
+
+Number::Number(const Number& other) :NumberType(other.NumberType)
+{
+    BitSize = other.BitSize;  // 复制位大小
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);  // 计算需要的字数
+
+    // 分配内存用于Data和Invalid
+    AllocateStorage(NeedGroup);
+
+    // 复制other对象的Data和Invalid内容到新对象
+    std::copy(other.Data, other.Data + NeedGroup, Data);
+#if defined(BIGNUMBER_TRACK_INVALID)
+    std::copy(other.Invalid, other.Invalid + NeedGroup, Invalid);
+#endif
+}
+
+Number::Number(Number&& other) noexcept :NumberType(other.NumberType)
+{
+    BitSize = other.BitSize;
+    StealStorage(other);
+}
+
+Number& Number::operator=(const Number& other)
+{
+    if (this == &other)  // 检查自赋值
+    {
+        return *this;
+    }
+
+    size_t NeedGroup = LimbOps::LimbCount(other.BitSize);  // 计算需要的字数
+
+    // 字数相同时直接复用当前的缓冲区，否则重新分配
+    if (NeedGroup != LimbOps::LimbCount(BitSize))
+    {
+        ReleaseStorage();
+        BitSize = 0;
+        AllocateStorage(NeedGroup);
+    }
+
+    BitSize = other.BitSize;  // 复制位大小
+    NumberType = other.NumberType;
+
+    // 复制other对象的Data和Invalid内容到当前对象
+    std::copy(other.Data, other.Data + NeedGroup, Data);
+#if defined(BIGNUMBER_TRACK_INVALID)
+    std::copy(other.Invalid, other.Invalid + NeedGroup, Invalid);
+#endif
+
+    return *this;  // 返回当前对象以支持链式赋值
+}
+
+Number& Number::operator=(Number&& other) noexcept
+{
+    if (this == &other)  // 检查自赋值
+    {
+        return *this;
+    }
+
+    ReleaseStorage();  // 释放当前对象的内存
+
+    BitSize = other.BitSize;
+    NumberType = other.NumberType;
+    StealStorage(other);
+
+    return *this;
+}
+
+void Number::AllocateStorage(size_t NeedGroup)
+{
+    if (NeedGroup <= InlineLimbs)
+    {
+        Data = InlineData;
+#if defined(BIGNUMBER_TRACK_INVALID)
+        Invalid = InlineInvalid;
+#endif
+        return;
+    }
+
+    Data = static_cast<Limb*>(malloc(NeedGroup * sizeof(Limb)));
+    INSTRUMENT_ALLOCATION(NeedGroup * sizeof(Limb));
+    bool failed = Data == nullptr;
+#if defined(BIGNUMBER_TRACK_INVALID)
+    Invalid = static_cast<Limb*>(malloc(NeedGroup * sizeof(Limb)));
+    INSTRUMENT_ALLOCATION(NeedGroup * sizeof(Limb));
+    failed = failed || Invalid == nullptr;
+#endif
+
+    // 检查内存分配是否成功
+    if (failed)
+    {
+        free(Data);  // 释放已分配的内存
+        Data = InlineData;
+#if defined(BIGNUMBER_TRACK_INVALID)
+        free(Invalid);
+        Invalid = InlineInvalid;
+#endif
+        BitSize = 0;
+        throw std::bad_alloc();  // 抛出内存分配失败异常
+    }
+}
+
+void Number::ReleaseStorage()
+{
+    if (Data != InlineData)
+    {
+        free(Data);
+#if defined(BIGNUMBER_TRACK_INVALID)
+        free(Invalid);
+#endif
+    }
+    Data = InlineData;
+#if defined(BIGNUMBER_TRACK_INVALID)
+    Invalid = InlineInvalid;
+#endif
+}
+
+void Number::StealStorage(Number& other)
+{
+    // 调用前 BitSize 已经设为 other.BitSize
+    if (other.Data == other.InlineData)
+    {
+        // 对象内缓冲区无法转移，只能复制
+        size_t NeedGroup = LimbOps::LimbCount(BitSize);
+        Data = InlineData;
+        std::copy(other.InlineData, other.InlineData + NeedGroup, InlineData);
+#if defined(BIGNUMBER_TRACK_INVALID)
+        Invalid = InlineInvalid;
+        std::copy(other.InlineInvalid, other.InlineInvalid + NeedGroup, InlineInvalid);
+#endif
+    }
+    else
+    {
+        Data = other.Data;
+#if defined(BIGNUMBER_TRACK_INVALID)
+        Invalid = other.Invalid;
+#endif
+    }
+
+    // 被移走的对象变为0位的空数
+    other.BitSize = 0;
+    other.Data = other.InlineData;
+#if defined(BIGNUMBER_TRACK_INVALID)
+    other.Invalid = other.InlineInvalid;
+#endif
+}
+
+void Number::ResizeStorage(size_t NewBitSize)
+{
+    size_t NeedGroup = LimbOps::LimbCount(NewBitSize);
+    if (NeedGroup != LimbOps::LimbCount(BitSize))
+    {
+        ReleaseStorage();
+        BitSize = 0;
+        AllocateStorage(NeedGroup);
+#if defined(BIGNUMBER_TRACK_INVALID)
+        std::fill_n(Invalid, NeedGroup, ~Limb(0));
+#endif
+    }
+    BitSize = NewBitSize;
+}
+
+void Number::ResizeSignExtend(size_t NewBitSize)
+{
+    size_t OldGroup = LimbOps::LimbCount(BitSize);
+    size_t NewGroup = LimbOps::LimbCount(NewBitSize);
+    if (NewGroup == OldGroup)
+    {
+        // 字数不变：只有最高字中的符号位变化
+        LimbOps::SignExtend(Data, NewGroup, Data, BitSize);
+#if defined(BIGNUMBER_TRACK_INVALID)
+        LimbOps::SignExtend(Invalid, NewGroup, Invalid, BitSize);
+#endif
+        BitSize = NewBitSize;
+        ClearUnusedBits();
+        return;
+    }
+
+    LimbOps::TempLimbs value(NewGroup);
+    LimbOps::SignExtend(value.data(), NewGroup, Data, BitSize);
+#if defined(BIGNUMBER_TRACK_INVALID)
+    // 符号位无效时，扩展出的位同样无效
+    LimbOps::TempLimbs invalid(NewGroup);
+    LimbOps::SignExtend(invalid.data(), NewGroup, Invalid, BitSize);
+#endif
+
+    ResizeStorage(NewBitSize);
+    std::copy(value.data(), value.data() + NewGroup, Data);
+#if defined(BIGNUMBER_TRACK_INVALID)
+    std::copy(invalid.data(), invalid.data() + NewGroup, Invalid);
+#endif
+    ClearUnusedBits();
+}
+
+void Number::SetBit(size_t BitIndex)
+{
+    // 检查 BitIndex 是否超出范围
+    if (BitIndex >= BitSize)
+    {
+        throw std::out_of_range("Bit index out of range");
+    }
+
+    // 设置特定位
+    Data[BitIndex / LIMB_BITS] |= Limb(1) << (BitIndex % LIMB_BITS);
+    MarkBitsValid(BitIndex, 1);
+}
+
+void Number::ClearBit(size_t BitIndex)
+{
+    // 检查 BitIndex 是否超出范围
+    if (BitIndex >= BitSize)
+    {
+        throw std::out_of_range("Bit index out of range");
+    }
+
+    // 清除特定位
+    Data[BitIndex / LIMB_BITS] &= ~(Limb(1) << (BitIndex % LIMB_BITS));
+    MarkBitsValid(BitIndex, 1);
+}
+
+void Number::ToggleBit(size_t BitIndex)
+{
+    // 检查 BitIndex 是否超出范围
+    if (BitIndex >= BitSize)
+    {
+        throw std::out_of_range("Bit index out of range");
+    }
+
+    // 切换特定位
+    Data[BitIndex / LIMB_BITS] ^= Limb(1) << (BitIndex % LIMB_BITS);
+}
+
+size_t Number::GetBitSize()const
+{
+    return BitSize;
+}
+
+int Number::GetBit(size_t BitIndex) const
+{
+    if (BitIndex >= BitSize) throw std::out_of_range("BitIndex out of range");
+
+    return (Data[BitIndex / LIMB_BITS] >> (BitIndex % LIMB_BITS)) & 1;
+}
+
+void Number::ToNegative()
+{
+    if (NumberType == Type::Integer)
+    {
+        // 整数：使用补码表示负数，按字取反加一。第 i 位只依赖第 0..i 位，最低的无效位以上都无效
+        LimbOps::Negate(Data, Data, LimbOps::LimbCount(BitSize));
+        ClearUnusedBits();
+        MarkInvalidFrom(LowestInvalidBit());
+    }
+    else if (NumberType == Type::FloatIngpoint)
+    {
+        // 浮点数：取反符号位
+        InvertSignBit();
+    }
+    else
+    {
+        throw std::runtime_error("Undefined number type");
+    }
+}
+
+const Limb* Number::GetData()const
+{
+    return Data;
+}
+
+size_t Number::GetLimbCount()const
+{
+    return LimbOps::LimbCount(BitSize);
+}
+
+std::vector<unsigned char> Number::GetBytes()const
+{
+    // 与原来的字节数组布局一致：高位字节在前
+    size_t NeedBytes = (BitSize + 7) / 8;
+    std::vector<unsigned char> bytes(NeedBytes);
+    for (size_t i = 0; i < NeedBytes; ++i)
+    {
+        bytes[NeedBytes - 1 - i] = static_cast<unsigned char>(Data[i / 8] >> (8 * (i % 8)));
+    }
+    return bytes;
+}
+
+Number::Type Number::GetType()
+{
+    return NumberType;
+}
+
+size_t Number::PopCount() const
+{
+    // 最高字中超出 BitSize 的位始终为0，不影响结果
+    return LimbOps::PopCount(Data, LimbOps::LimbCount(BitSize));
+}
+
+size_t Number::CountLeadingZeros() const
+{
+    return BitSize - BitLength();
+}
+
+size_t Number::CountTrailingZeros() const
+{
+    return FindNextSetBit(0);
+}
+
+size_t Number::BitLength() const
+{
+    return LimbOps::BitLength(Data, LimbOps::LimbCount(BitSize));
+}
+
+size_t Number::FindNextSetBit(size_t BitIndex) const
+{
+    if (BitIndex >= BitSize)
+    {
+        return BitSize;
+    }
+    return std::min(LimbOps::FindNextSet(Data, LimbOps::LimbCount(BitSize), BitIndex), BitSize);
+}
+
+Limb Number::ExtractBits(size_t BitIndex, size_t count) const
+{
+    checkBitRange(BitIndex, count);
+    return LimbOps::ExtractBits(Data, BitIndex, count);
+}
+
+void Number::InsertBits(size_t BitIndex, size_t count, Limb value)
+{
+    checkBitRange(BitIndex, count);
+    LimbOps::InsertBits(Data, BitIndex, count, value);
+    MarkBitsValid(BitIndex, count);
+}
+
+void Number::InvertSignBit()
+{
+    // 假设浮点数的符号位是最高位
+    ToggleBit(BitSize - 1);
+}
+
+void Number::ClearUnusedBits()
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    if (NeedGroup != 0)
+    {
+        Data[NeedGroup - 1] &= LimbOps::TopMask(BitSize);
+#if defined(BIGNUMBER_TRACK_INVALID)
+        Invalid[NeedGroup - 1] &= LimbOps::TopMask(BitSize);
+#endif
+    }
+}
+
+//void Number::add(const Number& other, bool subtract)
+//{
+//    if (BitSize != other.BitSize)
+//    {
+//        throw std::invalid_argument("Bit sizes do not match");
+//    }
+//
+//    size_t NeedGroup = (BitSize + 7) / 8;
+//    unsigned carry = subtract ? 1 : 0;  // If subtracting, start with carry as 1 to handle two's complement
+//    unsigned char* tempData = static_cast<unsigned char*>(malloc(NeedGroup));
+//
+//    if (tempData == nullptr)
+//    {
+//        throw std::bad_alloc();
+//    }
+//
+//    for (size_t i = 0; i < NeedGroup; ++i)
+//    {
+//        unsigned temp1 = Data[i];
+//        unsigned temp2 = other.Data[i];
+//
+//        if (subtract)
+//        {
+//            temp2 = ~temp2;
+//        }
+//
+//        unsigned sum = temp1 + temp2 + carry;
+//        carry = (sum > 0xFF) ? 1 : 0;
+//        tempData[i] = sum & 0xFF;
+//    }
+//
+//    std::copy(tempData, tempData + NeedGroup, Data);
+//    free(tempData);
+//
+//    if (subtract)
+//    {
+//        bool carry = true;
+//        for (size_t i = 0; i < BitSize && carry; ++i)
+//        {
+//            if (GetBit(i) == 0)
+//            {
+//                SetBit(i);
+//                carry = false;
+//            }
+//            else
+//            {
+//                ClearBit(i);
+//            }
+//        }
+//    }
+//}
+//
+//void Number::multiply(const Number& other)
+//{
+//    if (BitSize != other.BitSize)
+//    {
+//        throw std::invalid_argument("Bit sizes do not match");
+//    }
+//
+//    Number result(BitSize);
+//    Number temp(*this);
+//
+//    for (size_t i = 0; i < BitSize; ++i)
+//    {
+//        if (other.GetBit(i))
+//        {
+//            result += temp;
+//        }
+//        temp <<= 1;
+//    }
+//
+//    std::copy(result.Data, result.Data + (BitSize + 7) / 8, Data);
+//}
+//
+//void Number::divide(const Number& other)
+//{
+//    if (BitSize != other.BitSize)
+//    {
+//        throw std::invalid_argument("Bit sizes do not match");
+//    }
+//
+//    Number dividend(*this);
+//    Number divisor(other);
+//    Number quotient(BitSize);
+//    Number one(BitSize);
+//
+//    one.SetBit(0);
+//
+//    for (size_t i = BitSize; i > 0; --i)
+//    {
+//        quotient <<= 1;
+//        if (dividend >= divisor)
+//        {
+//            dividend -= divisor;
+//            quotient |= one;
+//        }
+//        divisor >>= 1;
+//    }
+//
+//    std::copy(quotient.Data, quotient.Data + (BitSize + 7) / 8, Data);
+//}
+
+Number& Number::operator&=(const Number& other)
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    INSTRUMENT_SCOPE(Instrument::Op::Bitwise, NeedGroup);
+    CombineInvalid(other, '&');
+    if (BitSize != other.BitSize)
+    {
+        // 位宽不同时 other 先符号扩展（或截断）到当前位宽
+        LimbOps::TempLimbs extended(NeedGroup);
+        LimbOps::SignExtend(extended.data(), NeedGroup, other.Data, other.BitSize);
+        LimbOps::And(Data, Data, extended.data(), NeedGroup);
+        ClearUnusedBits();
+        return *this;
+    }
+
+    LimbOps::And(Data, Data, other.Data, NeedGroup);
+
+    return *this;
+}
+
+Number& Number::operator|=(const Number& other)
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    INSTRUMENT_SCOPE(Instrument::Op::Bitwise, NeedGroup);
+    CombineInvalid(other, '|');
+    if (BitSize != other.BitSize)
+    {
+        // 位宽不同时 other 先符号扩展（或截断）到当前位宽
+        LimbOps::TempLimbs extended(NeedGroup);
+        LimbOps::SignExtend(extended.data(), NeedGroup, other.Data, other.BitSize);
+        LimbOps::Or(Data, Data, extended.data(), NeedGroup);
+        ClearUnusedBits();
+        return *this;
+    }
+
+    LimbOps::Or(Data, Data, other.Data, NeedGroup);
+
+    return *this;
+}
+
+Number& Number::operator^=(const Number& other)
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    INSTRUMENT_SCOPE(Instrument::Op::Bitwise, NeedGroup);
+    CombineInvalid(other, '^');
+    if (BitSize != other.BitSize)
+    {
+        // 位宽不同时 other 先符号扩展（或截断）到当前位宽
+        LimbOps::TempLimbs extended(NeedGroup);
+        LimbOps::SignExtend(extended.data(), NeedGroup, other.Data, other.BitSize);
+        LimbOps::Xor(Data, Data, extended.data(), NeedGroup);
+        ClearUnusedBits();
+        return *this;
+    }
+
+    LimbOps::Xor(Data, Data, other.Data, NeedGroup);
+
+    return *this;
+}
+
+Number& Number::operator<<=(size_t shift)
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    INSTRUMENT_SCOPE(Instrument::Op::Shift, NeedGroup);
+    ShiftInvalid(shift, true);
+    if (shift >= BitSize)
+    {
+        std::fill_n(Data, NeedGroup, 0);
+        return *this;
+    }
+
+    LimbOps::ShiftLeft(Data, Data, NeedGroup, shift);
+    ClearUnusedBits();
+
+    return *this;
+}
+
+Number& Number::operator>>=(size_t shift)
+{
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    INSTRUMENT_SCOPE(Instrument::Op::Shift, NeedGroup);
+    ShiftInvalid(shift, false);
+    if (shift >= BitSize)
+    {
+        std::fill_n(Data, NeedGroup, 0);
+        return *this;
+    }
+
+    LimbOps::ShiftRight(Data, Data, NeedGroup, shift);
+
+    return *this;
+}
+
+Number Number::operator~() const
+{
+    Number result(*this);
+    LimbOps::Not(result.Data, Data, LimbOps::LimbCount(BitSize));
+    result.ClearUnusedBits();
+    return result;
+}
+
+Number Number::operator<<(size_t shift) const&
+{
+    Number result = *this;
+    result <<= shift;
+    return result;
+}
+
+Number Number::operator<<(size_t shift) &&
+{
+    // 临时对象直接在原缓冲区上移位
+    *this <<= shift;
+    return std::move(*this);
+}
+
+Number Number::operator>>(size_t shift) const&
+{
+    Number result = *this;
+    result >>= shift;
+    return result;
+}
+
+Number Number::operator>>(size_t shift) &&
+{
+    *this >>= shift;
+    return std::move(*this);
+}
+
+Number::~Number()
+{
+    ReleaseStorage();
+}
+
+Number& Number::operator+=(const Number& other)
+{
+    add(other, false);
+    return *this;
+}
+
+Number& Number::operator-=(const Number& other)
+{
+    add(other, true);
+    return *this;
+}
+
+Number& Number::operator*=(const Number& other)
+{
+    multiply(other);
+    return *this;
+}
+
+Number& Number::operator/=(const Number& other)
+{
+    divide(other);
+    return *this;
+}
+
+Number& Number::operator%=(const Number& other)
+{
+    modulo(other);
+    return *this;
+}
+
+Number Number::operator+(const Number& other) const
+{
+    Number result(*this);
+    result += other;
+    return result;
+}
+
+Number Number::operator-(const Number& other) const
+{
+    Number result(*this);
+    result -= other;
+    return result;
+}
+
+Number Number::operator*(const Number& other) const
+{
+    Number result(*this);
+    result *= other;
+    return result;
+}
+
+Number Number::operator/(const Number& other) const
+{
+    Number result(*this);
+    result /= other;
+    return result;
+}
+
+Number Number::operator%(const Number& other) const
+{
+    Number result(*this);
+    result %= other;
+    return result;
+}
+
+// Helper function to check if a number is negative
+bool isNegative(const Number& num)
+{
+    return num.GetBit(num.GetBitSize() - 1) == 1;
+}
+
+int Number::Compare(const Number& other) const
+{
+    INSTRUMENT_SCOPE(Instrument::Op::Compare, std::max(GetLimbCount(), other.GetLimbCount()));
+    bool thisNegative = isNegative(*this);
+    bool otherNegative = isNegative(other);
+
+    if (thisNegative != otherNegative)
+    {
+        return thisNegative ? -1 : 1;
+    }
+
+    // 同号时补码按无符号比较的顺序就是数值的顺序，从最高字开始逐字比较
+    if (BitSize == other.BitSize)
+    {
+        return LimbOps::Compare(Data, other.Data, LimbOps::LimbCount(BitSize));
+    }
+
+    // 位宽不同时先符号扩展到相同的字数
+    size_t NeedGroup = std::max(LimbOps::LimbCount(BitSize), LimbOps::LimbCount(other.BitSize));
+    LimbOps::TempLimbs a(NeedGroup), b(NeedGroup);
+    LimbOps::SignExtend(a.data(), NeedGroup, Data, BitSize);
+    LimbOps::SignExtend(b.data(), NeedGroup, other.Data, other.BitSize);
+    return LimbOps::Compare(a.data(), b.data(), NeedGroup);
+}
+
+#if NUMBER_HAS_THREE_WAY_COMPARE
+std::strong_ordering Number::operator<=>(const Number& other) const
+{
+    return Compare(other) <=> 0;
+}
+#endif
+
+bool Number::operator==(const Number& other) const
+{
+    if (GetBitSize() != other.GetBitSize())
+    {
+        return Compare(other) == 0;
+    }
+
+    return std::memcmp(Data, other.Data, LimbOps::LimbCount(BitSize) * sizeof(Limb)) == 0;
+}
+
+bool Number::operator!=(const Number& other) const
+{
+    return !(*this == other);
+}
+
+bool Number::operator>=(const Number& other) const
+{
+    return Compare(other) >= 0;
+}
+
+bool Number::operator<=(const Number& other) const
+{
+    return Compare(other) <= 0;
+}
+
+bool Number::operator>(const Number& other) const
+{
+    return Compare(other) > 0;
+}
+
+bool Number::operator<(const Number& other) const
+{
+    return Compare(other) < 0;
+}
+
+void Number::checkBitIndex(size_t BitIndex) const
+{
+    if (BitIndex >= BitSize) throw std::out_of_range("BitIndex out of range");
+}
+
+void Number::checkBitRange(size_t BitIndex, size_t count) const
+{
+    if (count > LIMB_BITS) throw std::out_of_range("Bit count exceeds one limb");
+    if (BitIndex > BitSize || count > BitSize - BitIndex) throw std::out_of_range("Bit range out of range");
+}
+
+#if defined(BIGNUMBER_TRACK_INVALID)
+bool Number::IsValid() const
+{
+    return LimbOps::IsZero(Invalid, LimbOps::LimbCount(BitSize));
+}
+
+bool Number::IsBitValid(size_t BitIndex) const
+{
+    checkBitIndex(BitIndex);
+    return ((Invalid[BitIndex / LIMB_BITS] >> (BitIndex % LIMB_BITS)) & 1) == 0;
+}
+
+size_t Number::LowestInvalidBit() const
+{
+    return std::min(LimbOps::FindNextSet(Invalid, LimbOps::LimbCount(BitSize), 0), BitSize);
+}
+
+const Limb* Number::GetInvalid() const
+{
+    return Invalid;
+}
+
+void Number::MarkValid()
+{
+    std::fill_n(Invalid, LimbOps::LimbCount(BitSize), 0);
+}
+
+void Number::MarkBitInvalid(size_t BitIndex)
+{
+    checkBitIndex(BitIndex);
+    Invalid[BitIndex / LIMB_BITS] |= Limb(1) << (BitIndex % LIMB_BITS);
+}
+
+void Number::MarkInvalidFrom(size_t BitIndex)
+{
+    if (BitIndex >= BitSize)
+    {
+        return;
+    }
+
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    size_t first = BitIndex / LIMB_BITS;
+    Invalid[first] |= ~Limb(0) << (BitIndex % LIMB_BITS);
+    std::fill(Invalid + first + 1, Invalid + NeedGroup, ~Limb(0));
+    Invalid[NeedGroup - 1] &= LimbOps::TopMask(BitSize);
+}
+
+void Number::MarkBitsValid(size_t BitIndex, size_t count)
+{
+    LimbOps::InsertBits(Invalid, BitIndex, count, 0);
+}
+
+void Number::CombineInvalid(const Number& other, char op)
+{
+    // other 与数值一样先符号扩展（或截断）到当前位宽。other 可以就是 *this，先复制再写回
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    LimbOps::TempLimbs value(NeedGroup), invalid(NeedGroup);
+    LimbOps::SignExtend(value.data(), NeedGroup, other.Data, other.BitSize);
+    LimbOps::SignExtend(invalid.data(), NeedGroup, other.Invalid, other.BitSize);
+
+    for (size_t i = 0; i < NeedGroup; ++i)
+    {
+        Limb a = Data[i], b = value[i];
+        Limb ia = Invalid[i], ib = invalid[i];
+        Limb result = ia | ib;
+        if (op == '&')
+        {
+            // 任一方是已知的0时结果为0
+            result &= (a | ia) & (b | ib);
+        }
+        else if (op == '|')
+        {
+            // 任一方是已知的1时结果为1
+            result &= (~a | ia) & (~b | ib);
+        }
+        Invalid[i] = result;
+    }
+    if (NeedGroup != 0)
+    {
+        Invalid[NeedGroup - 1] &= LimbOps::TopMask(BitSize);
+    }
+}
+
+void Number::ShiftInvalid(size_t shift, bool left)
+{
+    // 移入的位是已知的0
+    size_t NeedGroup = LimbOps::LimbCount(BitSize);
+    if (shift >= BitSize)
+    {
+        std::fill_n(Invalid, NeedGroup, 0);
+        return;
+    }
+
+    if (left)
+    {
+        LimbOps::ShiftLeft(Invalid, Invalid, NeedGroup, shift);
+        Invalid[NeedGroup - 1] &= LimbOps::TopMask(BitSize);
+    }
+    else
+    {
+        LimbOps::ShiftRight(Invalid, Invalid, NeedGroup, shift);
+    }
+}
+#endif
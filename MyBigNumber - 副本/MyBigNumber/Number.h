@@ -1,72 +1,160 @@
-#pragma once
-
-#define SIZE_8BIT   8
-#define SIZE_16BIT  16
-#define SIZE_32BIT  32
-#define SIZE_64BIT  64
-#define SIZE_128BIT 128
-#define SIZE_256BIT 256
-#define SIZE_512BIT 512
-#define SIZE_1024BIT 1024
-
-class Number
-{
-public:
-	enum Type
-	{
-		Integer,
-		FloatIngpoint,
-		Undefine
-	};
-
-	Number(size_t BitSize);
-	Number(const Number& other); // 캯
-
-	void SetBit(size_t BitIndex);
-	void ClearBit(size_t BitIndex);
-	void ToggleBit(size_t BitIndex);
-	size_t GetBitSize()const;
-	int GetBit(size_t BitIndex) const;
-	void ToNegative();
-	const unsigned char* GetData()const;
-	Type GetType();
-
-	Number& operator&=(const Number& other);
-	Number& operator|=(const Number& other);
-	Number& operator^=(const Number& other);
-	Number& operator<<=(size_t shift);
-	Number& operator>>=(size_t shift);
-	Number operator~() const;
-	Number operator<<(size_t shift) const;
-	Number operator>>(size_t shift) const;
-	Number& operator+=(const Number& other);
-	Number& operator-=(const Number& other);
-	Number& operator*=(const Number& other);
-	Number& operator/=(const Number& other);
-	Number operator+(const Number& other) const;
-	Number operator-(const Number& other) const;
-	Number operator*(const Number& other) const;
-	Number operator/(const Number& other) const;
-
-	// غ
-	bool operator>=(const Number& other) const;
-	bool operator<=(const Number& other) const;
-	bool operator>(const Number& other) const;
-	bool operator<(const Number& other) const;
-
-	Number& operator=(const Number& other);  // ֵ
-	
-	virtual ~Number();
-protected:
-	Type NumberType;
-	size_t BitSize;
-	unsigned char* Data;
-	unsigned char* Invalid;
-
-	void InvertSignBit();
-	void checkBitIndex(size_t BitIndex) const;
-	virtual void add(const Number& other, bool subtract) {};
-	virtual void multiply(const Number& other) {};
-	virtual void divide(const Number& other) {};
-};
-
+#pragma once
+#include "LimbOps.h"
+#include <vector>
+
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
+#define NUMBER_HAS_THREE_WAY_COMPARE 1
+#else
+#define NUMBER_HAS_THREE_WAY_COMPARE 0
+#endif
+
+#define SIZE_8BIT   8
+#define SIZE_16BIT  16
+#define SIZE_32BIT  32
+#define SIZE_64BIT  64
+#define SIZE_128BIT 128
+#define SIZE_256BIT 256
+#define SIZE_512BIT 512
+#define SIZE_1024BIT 1024
+
+// 无效位（影子存储）：默认不编译，Number 只保存数值本身。定义 BIGNUMBER_TRACK_INVALID
+// （CMake 选项 BIGNUMBER_TRACK_INVALID=ON）后，每个数另有一组与数值等长的影子字，第 i 位为1表示
+// 数值的第 i 位未知。新建的 Number 所有位都无效，写入数值（构造 BigInt、SetBit、InsertBits 等）
+// 后变为有效；运算按字传播：
+//   &、|、^、~、移位逐位计算（与已知的0相与、与已知的1相或得到有效位，移入的位有效）；
+//   加、减、乘、取负的低位只依赖操作数的低位，从最低的无效位开始往上全部无效；
+//   除、取模以及 BigFloat 的运算，任一操作数有无效位时结果全部无效。
+// 视图、BigIntBatch、NumberFile 只保存数值，从中得到的数全部有效。
+// 该宏改变 Number 的布局，库和使用它的代码必须一致地定义
+class Number
+{
+public:
+	enum Type
+	{
+		Integer,
+		FloatIngpoint,
+		Undefine
+	};
+
+	Number(size_t BitSize);
+	Number(const Number& other); // 拷贝构造函数声明
+	Number(Number&& other) noexcept; // 移动构造函数声明
+
+	void SetBit(size_t BitIndex);
+	void ClearBit(size_t BitIndex);
+	void ToggleBit(size_t BitIndex);
+	size_t GetBitSize()const;
+	int GetBit(size_t BitIndex) const;
+	void ToNegative();
+	const Limb* GetData()const;  // 按字存储，Data[0] 为最低位字
+	size_t GetLimbCount()const;
+	std::vector<unsigned char> GetBytes()const;  // 按字节导出，高位字节在前
+	Type GetType();
+
+	// 按字查询位模式（把 BitSize 位看作无符号数，与符号无关）
+	size_t PopCount() const;            // 1的个数
+	size_t CountLeadingZeros() const;   // 从第 BitSize-1 位往下连续0的个数，全为0时返回 BitSize
+	size_t CountTrailingZeros() const;  // 从第0位往上连续0的个数，全为0时返回 BitSize
+	size_t BitLength() const;           // 最高的1所在位置加一，全为0时返回0
+	// 第 BitIndex 位（含）以上第一个为1的位，没有时返回 BitSize
+	size_t FindNextSetBit(size_t BitIndex) const;
+	// 读写第 BitIndex 位开始的 count 位（count <= 64），超出 BitSize 时抛出 std::out_of_range
+	Limb ExtractBits(size_t BitIndex, size_t count) const;
+	void InsertBits(size_t BitIndex, size_t count, Limb value);
+
+	// 无效位查询与标记。未定义 BIGNUMBER_TRACK_INVALID 时所有位都有效，标记函数不做任何事
+	bool IsValid() const;                   // 没有无效位
+	bool IsBitValid(size_t BitIndex) const;
+	size_t LowestInvalidBit() const;        // 最低的无效位，没有时返回 BitSize
+	const Limb* GetInvalid() const;         // 按字存储的影子，未跟踪时为 nullptr
+	void MarkValid();                       // 所有位标记为有效
+	void MarkBitInvalid(size_t BitIndex);
+	void MarkInvalidFrom(size_t BitIndex);  // 第 BitIndex 位及以上标记为无效，超出 BitSize 时不变
+
+	// 位宽不同时 other 先符号扩展（或截断）到当前位宽
+	Number& operator&=(const Number& other);
+	Number& operator|=(const Number& other);
+	Number& operator^=(const Number& other);
+	Number& operator<<=(size_t shift);
+	Number& operator>>=(size_t shift);
+	Number operator~() const;
+	Number operator<<(size_t shift) const&;
+	Number operator<<(size_t shift) &&;
+	Number operator>>(size_t shift) const&;
+	Number operator>>(size_t shift) &&;
+	Number& operator+=(const Number& other);
+	Number& operator-=(const Number& other);
+	Number& operator*=(const Number& other);
+	Number& operator/=(const Number& other);
+	Number& operator%=(const Number& other);
+	Number operator+(const Number& other) const;
+	Number operator-(const Number& other) const;
+	Number operator*(const Number& other) const;
+	Number operator/(const Number& other) const;
+	Number operator%(const Number& other) const;
+
+	// 有符号比较（补码），从最高字开始逐字比较，返回 -1 / 0 / 1。位宽可以不同，按符号扩展后的值比较
+	int Compare(const Number& other) const;
+#if NUMBER_HAS_THREE_WAY_COMPARE
+	std::strong_ordering operator<=>(const Number& other) const;
+#endif
+
+	// 运算符重载函数声明
+	bool operator==(const Number& other) const;
+	bool operator!=(const Number& other) const;
+	bool operator>=(const Number& other) const;
+	bool operator<=(const Number& other) const;
+	bool operator>(const Number& other) const;
+	bool operator<(const Number& other) const;
+
+	Number& operator=(const Number& other);  // 赋值操作符声明
+	Number& operator=(Number&& other) noexcept;  // 移动赋值操作符声明
+	
+	virtual ~Number();
+protected:
+	Type NumberType;
+	size_t BitSize;
+	Limb* Data;
+
+	// 不超过 SIZE_256BIT 的数直接存放在对象内，不需要分配堆内存
+	static const size_t InlineLimbs = SIZE_256BIT / LIMB_BITS;
+	Limb InlineData[InlineLimbs];
+#if defined(BIGNUMBER_TRACK_INVALID)
+	Limb* Invalid;
+	Limb InlineInvalid[InlineLimbs];
+#endif
+
+	void AllocateStorage(size_t NeedGroup);
+	void ReleaseStorage();
+	void StealStorage(Number& other);
+	void ResizeStorage(size_t NewBitSize);  // 改为 NewBitSize 位，字数变化时重新分配，原内容不保留
+	void ResizeSignExtend(size_t NewBitSize);  // 改为 NewBitSize 位，数值（与无效位）符号扩展或截断
+
+	// 运算中维护无效位，未跟踪时为空操作
+	void MarkBitsValid(size_t BitIndex, size_t count);  // count <= 64
+	void CombineInvalid(const Number& other, char op);  // op 为 '&'、'|'、'^'，在更新 Data 之前调用
+	void ShiftInvalid(size_t shift, bool left);
+
+	void InvertSignBit();
+	void ClearUnusedBits();  // 清除最高字中超出 BitSize 的位
+	void checkBitIndex(size_t BitIndex) const;
+	void checkBitRange(size_t BitIndex, size_t count) const;
+	virtual void add(const Number& other, bool subtract) {};
+	virtual void multiply(const Number& other) {};
+	virtual void divide(const Number& other) {};
+	virtual void modulo(const Number& other) {};
+};
+
+#if !defined(BIGNUMBER_TRACK_INVALID)
+inline bool Number::IsValid() const { return true; }
+inline bool Number::IsBitValid(size_t BitIndex) const { checkBitIndex(BitIndex); return true; }
+inline size_t Number::LowestInvalidBit() const { return BitSize; }
+inline const Limb* Number::GetInvalid() const { return nullptr; }
+inline void Number::MarkValid() {}
+inline void Number::MarkBitInvalid(size_t BitIndex) { checkBitIndex(BitIndex); }
+inline void Number::MarkInvalidFrom(size_t) {}
+inline void Number::MarkBitsValid(size_t, size_t) {}
+inline void Number::CombineInvalid(const Number&, char) {}
+inline void Number::ShiftInvalid(size_t, bool) {}
+#endif
@@ -0,0 +1,377 @@
+#include "NumberFile.h"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const size_t WriteBufferSize = size_t(1) << 20;
+
+    void StoreHeader(unsigned char* header, size_t BitSize)
+    {
+        std::uint64_t bits = BitSize;
+        std::uint64_t recordBytes = LimbOps::LimbCount(BitSize) * sizeof(Limb);
+        std::memset(header, 0, NumberFile::HeaderSize);
+        std::memcpy(header, NumberFile::Magic, sizeof(NumberFile::Magic));
+        std::memcpy(header + 8, &NumberFile::Version, sizeof(NumberFile::Version));
+        std::memcpy(header + 12, &NumberFile::ByteOrderMark, sizeof(NumberFile::ByteOrderMark));
+        std::memcpy(header + 16, &bits, sizeof(bits));
+        std::memcpy(header + 24, &recordBytes, sizeof(recordBytes));
+    }
+
+    // 检查文件头并返回位宽，格式不对时抛出 std::runtime_error
+    size_t LoadHeader(const unsigned char* header)
+    {
+        std::uint32_t version, byteOrder;
+        std::uint64_t bits, recordBytes;
+        std::memcpy(&version, header + 8, sizeof(version));
+        std::memcpy(&byteOrder, header + 12, sizeof(byteOrder));
+        std::memcpy(&bits, header + 16, sizeof(bits));
+        std::memcpy(&recordBytes, header + 24, sizeof(recordBytes));
+
+        if (std::memcmp(header, NumberFile::Magic, sizeof(NumberFile::Magic)) != 0)
+        {
+            throw std::runtime_error("Invalid number file");
+        }
+        if (version != NumberFile::Version)
+        {
+            throw std::runtime_error("Unsupported number file version");
+        }
+        if (byteOrder != NumberFile::ByteOrderMark)
+        {
+            throw std::runtime_error("Number file byte order does not match");
+        }
+        if (bits == 0 || recordBytes != LimbOps::LimbCount(static_cast<size_t>(bits)) * sizeof(Limb))
+        {
+            throw std::runtime_error("Invalid number file");
+        }
+        return static_cast<size_t>(bits);
+    }
+
+    // 超过 2GB 的文件需要64位的偏移
+    bool SeekTo(std::FILE* file, std::uint64_t offset, int origin)
+    {
+#if defined(_WIN32)
+        return _fseeki64(file, static_cast<long long>(offset), origin) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+    }
+
+    std::uint64_t Tell(std::FILE* file)
+    {
+#if defined(_WIN32)
+        return static_cast<std::uint64_t>(_ftelli64(file));
+#else
+        return static_cast<std::uint64_t>(ftello(file));
+#endif
+    }
+}
+
+NumberFileWriter::NumberFileWriter(const std::string& path, size_t BitSize, bool append)
+    :File(nullptr), BitSize(BitSize), RecordLimbs(LimbOps::LimbCount(BitSize)), Count(0), Buffer(WriteBufferSize)
+{
+    if (BitSize == 0)
+    {
+        throw std::invalid_argument("Bit size must be positive");
+    }
+
+    unsigned char header[NumberFile::HeaderSize];
+    if (append)
+    {
+        File = std::fopen(path.c_str(), "r+b");
+    }
+
+    bool created = false;
+    if (File == nullptr)
+    {
+        File = std::fopen(path.c_str(), "wb");
+        if (File == nullptr)
+        {
+            throw std::runtime_error("Cannot open number file");
+        }
+        created = true;
+    }
+    // setvbuf 必须在对流的其他任何操作之前调用
+    std::setvbuf(File, Buffer.data(), _IOFBF, Buffer.size());
+
+    try
+    {
+        if (created)
+        {
+            StoreHeader(header, BitSize);
+            Write(header, sizeof(header));
+            return;
+        }
+
+        if (std::fread(header, 1, sizeof(header), File) != sizeof(header))
+        {
+            throw std::runtime_error("Invalid number file");
+        }
+        if (LoadHeader(header) != BitSize)
+        {
+            throw std::invalid_argument("Bit sizes do not match");
+        }
+
+        // 从最后一条完整记录之后开始写，覆盖可能存在的不完整记录
+        size_t recordBytes = RecordLimbs * sizeof(Limb);
+        if (!SeekTo(File, 0, SEEK_END))
+        {
+            throw std::runtime_error("Cannot seek in number file");
+        }
+        Count = static_cast<size_t>((Tell(File) - NumberFile::HeaderSize) / recordBytes);
+        if (!SeekTo(File, NumberFile::HeaderSize + static_cast<std::uint64_t>(Count) * recordBytes, SEEK_SET))
+        {
+            throw std::runtime_error("Cannot seek in number file");
+        }
+    }
+    catch (...)
+    {
+        std::fclose(File);
+        File = nullptr;
+        throw;
+    }
+}
+
+NumberFileWriter::~NumberFileWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
+size_t NumberFileWriter::GetBitSize() const
+{
+    return BitSize;
+}
+
+size_t NumberFileWriter::size() const
+{
+    return Count;
+}
+
+void NumberFileWriter::Write(const void* data, size_t bytes)
+{
+    if (File == nullptr)
+    {
+        throw std::runtime_error("Number file is closed");
+    }
+    if (std::fwrite(data, 1, bytes, File) != bytes)
+    {
+        throw std::runtime_error("Cannot write number file");
+    }
+}
+
+void NumberFileWriter::Append(const ConstNumberView& value)
+{
+    if (value.GetBitSize() != BitSize)
+    {
+        throw std::invalid_argument("Bit sizes do not match");
+    }
+
+    if (value.GetLimbs() != nullptr)
+    {
+        WriteRecords(value.GetLimbs(), 1);
+    }
+    else
+    {
+        LimbOps::TempLimbs record(RecordLimbs);
+        value.Load(record.data(), RecordLimbs);
+        WriteRecords(record.data(), 1);
+    }
+    ++Count;
+}
+
+void NumberFileWriter::Append(const Limb* records, size_t count)
+{
+    WriteRecords(records, count);
+    Count += count;
+}
+
+void NumberFileWriter::WriteRecords(const Limb* records, size_t count)
+{
+    // 最高字中超出 BitSize 的位不属于数值（视图同样忽略它们），写入文件前清零
+    Limb mask = LimbOps::TopMask(BitSize);
+    if (mask == ~Limb(0))
+    {
+        Write(records, count * RecordLimbs * sizeof(Limb));
+        return;
+    }
+    for (size_t i = 0; i < count; ++i, records += RecordLimbs)
+    {
+        Limb top = records[RecordLimbs - 1] & mask;
+        Write(records, (RecordLimbs - 1) * sizeof(Limb));
+        Write(&top, sizeof(top));
+    }
+}
+
+void NumberFileWriter::Flush()
+{
+    if (File != nullptr && std::fflush(File) != 0)
+    {
+        throw std::runtime_error("Cannot write number file");
+    }
+}
+
+void NumberFileWriter::Close()
+{
+    if (File == nullptr)
+    {
+        return;
+    }
+
+    int result = std::fclose(File);
+    File = nullptr;
+    if (result != 0)
+    {
+        throw std::runtime_error("Cannot write number file");
+    }
+}
+
+NumberFileReader::NumberFileReader(const std::string& path)
+    :Base(nullptr), MappedSize(0), BitSize(0), RecordLimbs(0), Count(0)
+{
+#if defined(_WIN32)
+    FileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    MappingHandle = nullptr;
+    if (FileHandle == INVALID_HANDLE_VALUE)
+    {
+        FileHandle = nullptr;
+        throw std::runtime_error("Cannot open number file");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(FileHandle, &fileSize) || static_cast<std::uint64_t>(fileSize.QuadPart) < NumberFile::HeaderSize)
+    {
+        Unmap();
+        throw std::runtime_error("Invalid number file");
+    }
+    MappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+    MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = MappingHandle == nullptr ? nullptr : MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        Unmap();
+        throw std::runtime_error("Cannot map number file");
+    }
+#else
+    Descriptor = open(path.c_str(), O_RDONLY);
+    if (Descriptor < 0)
+    {
+        throw std::runtime_error("Cannot open number file");
+    }
+
+    struct stat status;
+    if (fstat(Descriptor, &status) != 0 || static_cast<std::uint64_t>(status.st_size) < NumberFile::HeaderSize)
+    {
+        Unmap();
+        throw std::runtime_error("Invalid number file");
+    }
+    MappedSize = static_cast<size_t>(status.st_size);
+
+    void* view = mmap(nullptr, MappedSize, PROT_READ, MAP_SHARED, Descriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        Unmap();
+        throw std::runtime_error("Cannot map number file");
+    }
+#endif
+    Base = static_cast<const unsigned char*>(view);
+
+    try
+    {
+        BitSize = LoadHeader(Base);
+    }
+    catch (...)
+    {
+        Unmap();
+        throw;
+    }
+    RecordLimbs = LimbOps::LimbCount(BitSize);
+    Count = (MappedSize - NumberFile::HeaderSize) / (RecordLimbs * sizeof(Limb));
+}
+
+NumberFileReader::~NumberFileReader()
+{
+    Unmap();
+}
+
+void NumberFileReader::Unmap()
+{
+#if defined(_WIN32)
+    if (Base != nullptr)
+    {
+        UnmapViewOfFile(Base);
+    }
+    if (MappingHandle != nullptr)
+    {
+        CloseHandle(MappingHandle);
+    }
+    if (FileHandle != nullptr)
+    {
+        CloseHandle(FileHandle);
+    }
+    MappingHandle = nullptr;
+    FileHandle = nullptr;
+#else
+    if (Base != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(Base), MappedSize);
+    }
+    if (Descriptor >= 0)
+    {
+        close(Descriptor);
+    }
+    Descriptor = -1;
+#endif
+    Base = nullptr;
+}
+
+size_t NumberFileReader::GetBitSize() const
+{
+    return BitSize;
+}
+
+size_t NumberFileReader::GetLimbCount() const
+{
+    return RecordLimbs;
+}
+
+size_t NumberFileReader::size() const
+{
+    return Count;
+}
+
+const Limb* NumberFileReader::data() const
+{
+    return reinterpret_cast<const Limb*>(Base + NumberFile::HeaderSize);
+}
+
+const Limb* NumberFileReader::Record(size_t index) const
+{
+    if (index >= Count)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    return data() + index * RecordLimbs;
+}
+
+BigInt NumberFileReader::Get(size_t index) const
+{
+    return BigInt(Record(index), BitSize);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "BigInt.h"
+#include "LimbOps.h"
+#include "Number.h"
+#include "NumberView.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 同一位宽的一串定长整数的二进制文件格式（版本1）：
+//
+//     偏移  大小  内容
+//     0     8     魔数 "MYBIGNUM"
+//     8     4     版本号，当前为1
+//     12    4     字节序标记 0x01020304（按写入方的本机字节序存放）
+//     16    8     BitSize
+//     24    8     每条记录的字节数，LimbCount(BitSize) * 8
+//     32    ...   记录，每条是 LimbCount(BitSize) 个字（补码，低位字在前，与 Number::GetData 相同）
+//
+// 记录数由文件大小得出，不在文件头里，所以追加写入时不需要回写文件头；写到一半中断时末尾不完整的记录被忽略，
+// 下次追加会从它的位置开始覆盖。记录从第32字节开始，映射到内存后每个字都是对齐的
+namespace NumberFile
+{
+	const char Magic[8] = { 'M', 'Y', 'B', 'I', 'G', 'N', 'U', 'M' };
+	const std::uint32_t Version = 1;
+	const std::uint32_t ByteOrderMark = 0x01020304;
+	const size_t HeaderSize = 32;
+}
+
+// 顺序写入记录。数据先进入1MB的缓冲区，整条记录直接按字写出，不做任何转换
+class NumberFileWriter
+{
+public:
+	// append 为 false 时新建文件（已存在则清空）；为 true 时在已有文件末尾追加，
+	// 文件不存在则新建，已有文件的位宽与 BitSize 不同时抛出 std::invalid_argument
+	NumberFileWriter(const std::string& path, size_t BitSize, bool append = false);
+	~NumberFileWriter();
+
+	NumberFileWriter(const NumberFileWriter&) = delete;
+	NumberFileWriter& operator=(const NumberFileWriter&) = delete;
+
+	size_t GetBitSize() const;
+	size_t size() const;   // 文件中的记录数（包括已有的和本次写入的）
+
+	void Append(const ConstNumberView& value);        // value 的位宽必须等于 BitSize，字节视图先转换成字
+	void Append(const Limb* records, size_t count);   // count 条连续存放的记录，每条 LimbCount(BitSize) 个字，超出 BitSize 的位不写入
+	void Flush();
+	void Close();   // 析构时自动调用
+
+private:
+	std::FILE* File;
+	size_t BitSize;
+	size_t RecordLimbs;
+	size_t Count;
+	std::vector<char> Buffer;
+
+	void Write(const void* data, size_t bytes);
+	void WriteRecords(const Limb* records, size_t count);   // 清除每条记录最高字中超出 BitSize 的位后写入
+};
+
+// 把文件只读映射到内存，Record 直接返回映射中的地址，不复制也不解析。
+// 读取期间不要用 NumberFileWriter 写同一个文件
+class NumberFileReader
+{
+public:
+	explicit NumberFileReader(const std::string& path);
+	~NumberFileReader();
+
+	NumberFileReader(const NumberFileReader&) = delete;
+	NumberFileReader& operator=(const NumberFileReader&) = delete;
+
+	size_t GetBitSize() const;
+	size_t GetLimbCount() const;   // 每条记录的字数
+	size_t size() const;
+
+	const Limb* data() const;                 // 第一条记录，所有记录连续存放
+	const Limb* Record(size_t index) const;   // index 越界时抛出 std::out_of_range
+	BigInt Get(size_t index) const;
+
+private:
+	const unsigned char* Base;
+	size_t MappedSize;
+	size_t BitSize;
+	size_t RecordLimbs;
+	size_t Count;
+#if defined(_WIN32)
+	void* FileHandle;
+	void* MappingHandle;
+#else
+	int Descriptor;
+#endif
+
+	void Unmap();
+};
@@ -0,0 +1,453 @@
+#include "NumberView.h"
+#include "BigInt.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    inline Limb ByteSwap(Limb x)
+    {
+#if defined(_MSC_VER)
+        return _byteswap_uint64(x);
+#elif defined(__GNUC__)
+        return __builtin_bswap64(x);
+#else
+        Limb r = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            r = (r << 8) | ((x >> (8 * i)) & 0xFF);
+        }
+        return r;
+#endif
+    }
+
+    // 从任意对齐的地址读写一个小端序的字
+    inline Limb LoadLittle(const unsigned char* p)
+    {
+        Limb x;
+        std::memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = ByteSwap(x);
+#endif
+        return x;
+    }
+
+    inline void StoreLittle(unsigned char* p, Limb x)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = ByteSwap(x);
+#endif
+        std::memcpy(p, &x, sizeof(x));
+    }
+
+    // 字节视图中第 i 个字节（按数值从低到高）的地址
+    inline size_t ByteOffset(size_t i, size_t bytes, bool bigEndian)
+    {
+        return bigEndian ? bytes - 1 - i : i;
+    }
+
+    // 把 bytes 个字节解码到 r[0..count)，count 个字之外的字节不读；不足的高位补0。
+    // 整字一次读入（大端序再交换字节），只有最高的不完整字逐字节拼接
+    void DecodeBytes(Limb* r, size_t count, const unsigned char* data, size_t bytes, bool bigEndian)
+    {
+        size_t whole = std::min(count, bytes / 8);
+        for (size_t i = 0; i < whole; ++i)
+        {
+            r[i] = bigEndian ? ByteSwap(LoadLittle(data + bytes - 8 * (i + 1))) : LoadLittle(data + 8 * i);
+        }
+        for (size_t i = whole; i < count; ++i)
+        {
+            Limb word = 0;
+            for (size_t k = 8 * i; k < std::min(bytes, 8 * i + 8); ++k)
+            {
+                word |= Limb(data[ByteOffset(k, bytes, bigEndian)]) << (8 * (k - 8 * i));
+            }
+            r[i] = word;
+        }
+    }
+
+    void EncodeBytes(unsigned char* data, size_t bytes, bool bigEndian, const Limb* a)
+    {
+        size_t whole = bytes / 8;
+        for (size_t i = 0; i < whole; ++i)
+        {
+            if (bigEndian)
+            {
+                StoreLittle(data + bytes - 8 * (i + 1), ByteSwap(a[i]));
+            }
+            else
+            {
+                StoreLittle(data + 8 * i, a[i]);
+            }
+        }
+        for (size_t k = 8 * whole; k < bytes; ++k)
+        {
+            data[ByteOffset(k, bytes, bigEndian)] = static_cast<unsigned char>(a[k / 8] >> (8 * (k % 8)));
+        }
+    }
+
+    void CheckBitSize(size_t BitSize)
+    {
+        if (BitSize == 0)
+        {
+            throw std::invalid_argument("Bit size must be positive");
+        }
+    }
+}
+
+ConstNumberView::ConstNumberView(const Limb* limbs, size_t BitSize)
+    :Storage(reinterpret_cast<const unsigned char*>(limbs)), BitSize(BitSize), StorageLayout(Layout::Limbs)
+{
+    CheckBitSize(BitSize);
+}
+
+ConstNumberView::ConstNumberView(const unsigned char* bytes, size_t BitSize, ByteOrder order)
+    :Storage(bytes), BitSize(BitSize),
+    StorageLayout(order == ByteOrder::BigEndian ? Layout::BigEndianBytes : Layout::LittleEndianBytes)
+{
+    CheckBitSize(BitSize);
+}
+
+ConstNumberView::ConstNumberView(const Number& number)
+    :Storage(reinterpret_cast<const unsigned char*>(number.GetData())), BitSize(number.GetBitSize()), StorageLayout(Layout::Limbs)
+{
+}
+
+size_t ConstNumberView::GetBitSize() const
+{
+    return BitSize;
+}
+
+size_t ConstNumberView::GetLimbCount() const
+{
+    return LimbOps::LimbCount(BitSize);
+}
+
+size_t ConstNumberView::GetByteCount() const
+{
+    return (BitSize + 7) / 8;
+}
+
+const Limb* ConstNumberView::GetLimbs() const
+{
+    return StorageLayout == Layout::Limbs ? reinterpret_cast<const Limb*>(Storage) : nullptr;
+}
+
+int ConstNumberView::GetBit(size_t BitIndex) const
+{
+    if (BitIndex >= BitSize)
+    {
+        throw std::out_of_range("Bit index out of range");
+    }
+
+    if (StorageLayout == Layout::Limbs)
+    {
+        return static_cast<int>((GetLimbs()[BitIndex / LIMB_BITS] >> (BitIndex % LIMB_BITS)) & 1);
+    }
+    size_t offset = ByteOffset(BitIndex / 8, GetByteCount(), StorageLayout == Layout::BigEndianBytes);
+    return (Storage[offset] >> (BitIndex % 8)) & 1;
+}
+
+bool ConstNumberView::IsNegative() const
+{
+    return GetBit(BitSize - 1) == 1;
+}
+
+bool ConstNumberView::IsZero() const
+{
+    if (StorageLayout == Layout::Limbs)
+    {
+        size_t NeedGroup = GetLimbCount();
+        const Limb* limbs = GetLimbs();
+        return LimbOps::IsZero(limbs, NeedGroup - 1) && (limbs[NeedGroup - 1] & LimbOps::TopMask(BitSize)) == 0;
+    }
+
+    size_t bytes = GetByteCount();
+    size_t top = ByteOffset(bytes - 1, bytes, StorageLayout == Layout::BigEndianBytes);
+    unsigned char mask = static_cast<unsigned char>(0xFF >> ((8 - BitSize % 8) % 8));
+    if ((Storage[top] & mask) != 0)
+    {
+        return false;
+    }
+    const unsigned char* rest = StorageLayout == Layout::BigEndianBytes ? Storage + 1 : Storage;
+    return std::all_of(rest, rest + bytes - 1, [](unsigned char c) { return c == 0; });
+}
+
+void ConstNumberView::Load(Limb* r, size_t n) const
+{
+    size_t NeedGroup = GetLimbCount();
+    size_t count = std::min(n, NeedGroup);
+    if (StorageLayout == Layout::Limbs)
+    {
+        std::copy(GetLimbs(), GetLimbs() + count, r);
+    }
+    else
+    {
+        DecodeBytes(r, count, Storage, GetByteCount(), StorageLayout == Layout::BigEndianBytes);
+    }
+    if (n < NeedGroup)
+    {
+        return;
+    }
+
+    // 最高字中超出 BitSize 的位换成符号位
+    Limb mask = LimbOps::TopMask(BitSize);
+    Limb fill = IsNegative() ? ~Limb(0) : 0;
+    r[NeedGroup - 1] = (r[NeedGroup - 1] & mask) | (fill & ~mask);
+    std::fill(r + NeedGroup, r + n, fill);
+}
+
+BigInt ConstNumberView::ToBigInt() const
+{
+    if (StorageLayout == Layout::Limbs)
+    {
+        return BigInt(GetLimbs(), BitSize);
+    }
+
+    LimbOps::TempLimbs value(GetLimbCount());
+    Load(value.data(), value.size());
+    return BigInt(value.data(), BitSize);
+}
+
+std::string ConstNumberView::ToString() const
+{
+    LimbOps::TempLimbs magnitude(GetLimbCount());
+    Load(magnitude.data(), magnitude.size());
+    bool negative = LimbOps::Magnitude(magnitude.data(), magnitude.data(), BitSize);
+
+    std::string result;
+    if (negative)
+    {
+        result.push_back('-');
+    }
+    LimbOps::ToDecimal(result, magnitude.data(), magnitude.size());
+    return result;
+}
+
+int ConstNumberView::Compare(const ConstNumberView& other) const
+{
+    bool negative = IsNegative();
+    if (negative != other.IsNegative())
+    {
+        return negative ? -1 : 1;
+    }
+
+    // 符号相同，符号扩展到同样的字数后按无符号数比较
+    size_t NeedGroup = std::max(GetLimbCount(), other.GetLimbCount());
+    LimbOps::TempLimbs a(NeedGroup), b(NeedGroup);
+    Load(a.data(), NeedGroup);
+    other.Load(b.data(), NeedGroup);
+    return LimbOps::Compare(a.data(), b.data(), NeedGroup);
+}
+
+bool operator==(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) == 0;
+}
+
+bool operator!=(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) != 0;
+}
+
+bool operator<(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) < 0;
+}
+
+bool operator<=(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) <= 0;
+}
+
+bool operator>(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) > 0;
+}
+
+bool operator>=(const ConstNumberView& a, const ConstNumberView& b)
+{
+    return a.Compare(b) >= 0;
+}
+
+NumberView::NumberView(Limb* limbs, size_t BitSize)
+    :ConstNumberView(limbs, BitSize)
+{
+}
+
+NumberView::NumberView(unsigned char* bytes, size_t BitSize, ByteOrder order)
+    :ConstNumberView(bytes, BitSize, order)
+{
+}
+
+Limb* NumberView::BeginUpdate(LimbOps::TempLimbs& scratch)
+{
+    Limb* value = const_cast<Limb*>(GetLimbs());
+    if (value == nullptr)
+    {
+        value = scratch.data();
+        Load(value, GetLimbCount());
+    }
+
+    // 清除最高字中多余的位，避免右移时移进有效位
+    value[GetLimbCount() - 1] &= LimbOps::TopMask(BitSize);
+    return value;
+}
+
+void NumberView::EndUpdate(Limb* value)
+{
+    value[GetLimbCount() - 1] &= LimbOps::TopMask(BitSize);
+    if (StorageLayout != Layout::Limbs)
+    {
+        EncodeBytes(const_cast<unsigned char*>(Storage), GetByteCount(), StorageLayout == Layout::BigEndianBytes, value);
+    }
+}
+
+template <class Op>
+NumberView& NumberView::Combine(const ConstNumberView& other, Op op)
+{
+    size_t NeedGroup = GetLimbCount();
+
+    // 同位宽、按字存储的操作数直接使用，其余的先符号扩展（或截断）到本视图的字数
+    const Limb* b = other.GetBitSize() == BitSize ? other.GetLimbs() : nullptr;
+    LimbOps::TempLimbs extended(b == nullptr ? NeedGroup : 0);
+    if (b == nullptr)
+    {
+        other.Load(extended.data(), NeedGroup);
+        b = extended.data();
+    }
+
+    LimbOps::TempLimbs scratch(StorageLayout == Layout::Limbs ? 0 : NeedGroup);
+    Limb* value = BeginUpdate(scratch);
+    op(value, b, NeedGroup);
+    EndUpdate(value);
+    return *this;
+}
+
+void NumberView::Assign(const ConstNumberView& value)
+{
+    size_t NeedGroup = GetLimbCount();
+    LimbOps::TempLimbs scratch(StorageLayout == Layout::Limbs ? 0 : NeedGroup);
+    Limb* target = StorageLayout == Layout::Limbs ? const_cast<Limb*>(GetLimbs()) : scratch.data();
+    value.Load(target, NeedGroup);
+    EndUpdate(target);
+}
+
+void NumberView::SetBit(size_t BitIndex)
+{
+    GetBit(BitIndex);
+    if (StorageLayout == Layout::Limbs)
+    {
+        const_cast<Limb*>(GetLimbs())[BitIndex / LIMB_BITS] |= Limb(1) << (BitIndex % LIMB_BITS);
+        return;
+    }
+    size_t offset = ByteOffset(BitIndex / 8, GetByteCount(), StorageLayout == Layout::BigEndianBytes);
+    const_cast<unsigned char*>(Storage)[offset] |= static_cast<unsigned char>(1 << (BitIndex % 8));
+}
+
+void NumberView::ClearBit(size_t BitIndex)
+{
+    GetBit(BitIndex);
+    if (StorageLayout == Layout::Limbs)
+    {
+        const_cast<Limb*>(GetLimbs())[BitIndex / LIMB_BITS] &= ~(Limb(1) << (BitIndex % LIMB_BITS));
+        return;
+    }
+    size_t offset = ByteOffset(BitIndex / 8, GetByteCount(), StorageLayout == Layout::BigEndianBytes);
+    const_cast<unsigned char*>(Storage)[offset] &= static_cast<unsigned char>(~(1 << (BitIndex % 8)));
+}
+
+void NumberView::ToggleBit(size_t BitIndex)
+{
+    GetBit(BitIndex);
+    if (StorageLayout == Layout::Limbs)
+    {
+        const_cast<Limb*>(GetLimbs())[BitIndex / LIMB_BITS] ^= Limb(1) << (BitIndex % LIMB_BITS);
+        return;
+    }
+    size_t offset = ByteOffset(BitIndex / 8, GetByteCount(), StorageLayout == Layout::BigEndianBytes);
+    const_cast<unsigned char*>(Storage)[offset] ^= static_cast<unsigned char>(1 << (BitIndex % 8));
+}
+
+void NumberView::ToNegative()
+{
+    LimbOps::TempLimbs scratch(StorageLayout == Layout::Limbs ? 0 : GetLimbCount());
+    Limb* value = BeginUpdate(scratch);
+    LimbOps::Negate(value, value, GetLimbCount());
+    EndUpdate(value);
+}
+
+NumberView& NumberView::operator+=(const ConstNumberView& other)
+{
+    return Combine(other, [](Limb* r, const Limb* b, size_t n) { LimbOps::Add(r, r, b, n); });
+}
+
+NumberView& NumberView::operator-=(const ConstNumberView& other)
+{
+    return Combine(other, [](Limb* r, const Limb* b, size_t n) { LimbOps::Sub(r, r, b, n); });
+}
+
+NumberView& NumberView::operator*=(const ConstNumberView& other)
+{
+    size_t bits = BitSize;
+    return Combine(other, [bits](Limb* r, const Limb* b, size_t) { LimbOps::SignedMulLow(r, r, b, bits); });
+}
+
+NumberView& NumberView::operator&=(const ConstNumberView& other)
+{
+    return Combine(other, [](Limb* r, const Limb* b, size_t n) { LimbOps::And(r, r, b, n); });
+}
+
+NumberView& NumberView::operator|=(const ConstNumberView& other)
+{
+    return Combine(other, [](Limb* r, const Limb* b, size_t n) { LimbOps::Or(r, r, b, n); });
+}
+
+NumberView& NumberView::operator^=(const ConstNumberView& other)
+{
+    return Combine(other, [](Limb* r, const Limb* b, size_t n) { LimbOps::Xor(r, r, b, n); });
+}
+
+void NumberView::DivideInPlace(const ConstNumberView& other, bool remainder)
+{
+    // 与 BigInt 相同：较宽的除数让运算临时按它的位宽进行，结果再截断回本视图的位宽
+    size_t width = std::max(BitSize, other.GetBitSize());
+    size_t NeedGroup = LimbOps::LimbCount(width);
+    LimbOps::TempLimbs a(NeedGroup), b(NeedGroup);
+    Load(a.data(), NeedGroup);
+    other.Load(b.data(), NeedGroup);
+
+    LimbOps::SignedDivRem(remainder ? nullptr : a.data(), remainder ? a.data() : nullptr, a.data(), b.data(), width);
+    Assign(ConstNumberView(a.data(), width));
+}
+
+NumberView& NumberView::operator/=(const ConstNumberView& other)
+{
+    DivideInPlace(other, false);
+    return *this;
+}
+
+NumberView& NumberView::operator%=(const ConstNumberView& other)
+{
+    DivideInPlace(other, true);
+    return *this;
+}
+
+NumberView& NumberView::operator<<=(size_t shift)
+{
+    LimbOps::TempLimbs scratch(StorageLayout == Layout::Limbs ? 0 : GetLimbCount());
+    Limb* value = BeginUpdate(scratch);
+    LimbOps::ShiftLeft(value, value, GetLimbCount(), shift);
+    EndUpdate(value);
+    return *this;
+}
+
+NumberView& NumberView::operator>>=(size_t shift)
+{
+    LimbOps::TempLimbs scratch(StorageLayout == Layout::Limbs ? 0 : GetLimbCount());
+    Limb* value = BeginUpdate(scratch);
+    LimbOps::ShiftRight(value, value, GetLimbCount(), shift);
+    EndUpdate(value);
+    return *this;
+}
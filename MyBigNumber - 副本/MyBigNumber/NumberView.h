@@ -0,0 +1,99 @@
+#pragma once
+#include "LimbOps.h"
+#include "Number.h"
+#include <string>
+
+class BigInt;
+
+// 字节视图的字节序
+enum class ByteOrder
+{
+	LittleEndian,   // 最低位字节在前
+	BigEndian       // 最高位字节在前（网络字节序，与 Number::GetBytes 相同）
+};
+
+// 对调用方存储的只读视图，表示一个 BitSize 位的补码整数，不复制也不分配内存，
+// 视图存在期间存储必须保持有效。可以引用按字存储的数据（低位字在前，与 Number::GetData 相同，
+// 最高字中超出 BitSize 的位被忽略），也可以引用 (BitSize + 7) / 8 个任意对齐的字节。
+// Number 可以隐式转换为视图，所以接受 ConstNumberView 的函数同样接受 BigInt
+class ConstNumberView
+{
+public:
+	ConstNumberView(const Limb* limbs, size_t BitSize);
+	ConstNumberView(const unsigned char* bytes, size_t BitSize, ByteOrder order);
+	ConstNumberView(const Number& number);
+
+	size_t GetBitSize() const;
+	size_t GetLimbCount() const;
+	size_t GetByteCount() const;
+	const Limb* GetLimbs() const;   // 按字存储时返回数据地址，字节视图返回 nullptr
+	int GetBit(size_t BitIndex) const;
+	bool IsNegative() const;
+	bool IsZero() const;
+
+	// 按字取出值，符号扩展（或截断）到 r[0..n)
+	void Load(Limb* r, size_t n) const;
+
+	BigInt ToBigInt() const;
+	std::string ToString() const;
+
+	// 有符号比较，位宽可以不同，返回 -1 / 0 / 1
+	int Compare(const ConstNumberView& other) const;
+
+protected:
+	enum class Layout
+	{
+		Limbs,
+		LittleEndianBytes,
+		BigEndianBytes
+	};
+
+	const unsigned char* Storage;
+	size_t BitSize;
+	Layout StorageLayout;
+};
+
+bool operator==(const ConstNumberView& a, const ConstNumberView& b);
+bool operator!=(const ConstNumberView& a, const ConstNumberView& b);
+bool operator<(const ConstNumberView& a, const ConstNumberView& b);
+bool operator<=(const ConstNumberView& a, const ConstNumberView& b);
+bool operator>(const ConstNumberView& a, const ConstNumberView& b);
+bool operator>=(const ConstNumberView& a, const ConstNumberView& b);
+
+// 可写视图：原地运算直接写回调用方的存储，语义与 BigInt 的复合赋值相同（按 BitSize 位回绕，
+// 位宽不同的操作数先符号扩展）。按字存储时直接在原数据上运算；字节视图先转换到栈上的缓冲区
+// （不超过2048位时不分配内存），运算后再写回
+class NumberView :public ConstNumberView
+{
+public:
+	NumberView(Limb* limbs, size_t BitSize);
+	NumberView(unsigned char* bytes, size_t BitSize, ByteOrder order);
+
+	void Assign(const ConstNumberView& value);   // 写入 value（符号扩展或截断到 BitSize 位）
+
+	void SetBit(size_t BitIndex);
+	void ClearBit(size_t BitIndex);
+	void ToggleBit(size_t BitIndex);
+	void ToNegative();
+
+	NumberView& operator+=(const ConstNumberView& other);
+	NumberView& operator-=(const ConstNumberView& other);
+	NumberView& operator*=(const ConstNumberView& other);
+	NumberView& operator/=(const ConstNumberView& other);   // 除数为0时抛出 std::domain_error
+	NumberView& operator%=(const ConstNumberView& other);
+	NumberView& operator&=(const ConstNumberView& other);
+	NumberView& operator|=(const ConstNumberView& other);
+	NumberView& operator^=(const ConstNumberView& other);
+	NumberView& operator<<=(size_t shift);
+	NumberView& operator>>=(size_t shift);   // 逻辑移位，与 Number 相同
+
+private:
+	// 取得可以原地修改的字：按字存储时就是原数据，否则解码到 scratch
+	Limb* BeginUpdate(LimbOps::TempLimbs& scratch);
+	// 清除超出 BitSize 的位，字节视图再编码写回
+	void EndUpdate(Limb* value);
+	// value = op(value, other)，other 先对齐到本视图的位宽
+	template <class Op>
+	NumberView& Combine(const ConstNumberView& other, Op op);
+	void DivideInPlace(const ConstNumberView& other, bool remainder);
+};
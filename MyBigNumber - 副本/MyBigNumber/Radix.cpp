@@ -0,0 +1,416 @@
+#include "LimbOps.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// 不超过该字数时逐次除以 10^19 转换，否则按缓存的 10^(19*2^k) 分治，可在编译时覆盖
+#ifndef TOSTR_DC_THRESHOLD
+#define TOSTR_DC_THRESHOLD 30
+#endif
+
+// 十进制输入超过该位数时按缓存的10的幂分治解析，可在编译时覆盖
+#ifndef FROMSTR_DC_THRESHOLD
+#define FROMSTR_DC_THRESHOLD 600
+#endif
+
+namespace
+{
+    const Limb ChunkBase = 10000000000000000000ULL;   // 10^19，一个字能容纳的最大的10的幂
+    const size_t ChunkDigits = 19;
+
+    // 缓存的 10^(19*2^k)，所有线程共用。deque 追加元素时不会移动已有元素
+    std::deque<std::vector<Limb>> DecimalPowers;
+    std::mutex DecimalPowersMutex;
+
+    const std::vector<Limb>& DecimalPower(size_t k)
+    {
+        std::lock_guard<std::mutex> lock(DecimalPowersMutex);
+        if (DecimalPowers.empty())
+        {
+            DecimalPowers.push_back(std::vector<Limb>(1, ChunkBase));
+        }
+        while (DecimalPowers.size() <= k)
+        {
+            const std::vector<Limb>& last = DecimalPowers.back();
+            std::vector<Limb> square(2 * last.size());
+            LimbOps::Mul(square.data(), last.data(), last.size(), last.data(), last.size());
+            square.resize(LimbOps::Normalized(square.data(), square.size()));
+            DecimalPowers.push_back(std::move(square));
+        }
+        return DecimalPowers[k];
+    }
+
+    const char LowerDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const char UpperDigits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    void CheckRadix(int radix)
+    {
+        if (radix < 2 || radix > 36)
+        {
+            throw std::invalid_argument("Radix must be between 2 and 36");
+        }
+    }
+
+    // 2 的幂进制每个数字的位数，其他进制返回0
+    unsigned BitsPerDigit(int radix)
+    {
+        if ((radix & (radix - 1)) != 0)
+        {
+            return 0;
+        }
+        unsigned bits = 0;
+        while ((1 << bits) < radix)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+    // 一个字能容纳的 radix 的最大幂 radix^chunkDigits
+    Limb LargestChunkBase(int radix, size_t& chunkDigits)
+    {
+        Limb chunkBase = static_cast<Limb>(radix);
+        chunkDigits = 1;
+        while (chunkBase <= ~Limb(0) / static_cast<Limb>(radix))
+        {
+            chunkBase *= static_cast<Limb>(radix);
+            ++chunkDigits;
+        }
+        return chunkBase;
+    }
+
+    // 输出先攒在固定大小的缓冲区里，满了再整块交给 sink，转换很大的数时也不需要完整的字符串
+    class TextWriter
+    {
+    public:
+        TextWriter(const LimbOps::TextSink& sink, const char* alphabet) :Sink(sink), Alphabet(alphabet), Count(0) {}
+        TextWriter(const TextWriter&) = delete;
+        TextWriter& operator=(const TextWriter&) = delete;
+
+        void Put(char c)
+        {
+            if (Count == sizeof(Buffer))
+            {
+                Flush();
+            }
+            Buffer[Count++] = c;
+        }
+
+        void PutDigit(Limb digit)
+        {
+            Put(Alphabet[digit]);
+        }
+
+        void Fill(char c, size_t count)
+        {
+            for (; count > 0; --count)
+            {
+                Put(c);
+            }
+        }
+
+        void Flush()
+        {
+            if (Count != 0)
+            {
+                Sink(Buffer, Count);
+                Count = 0;
+            }
+        }
+
+    private:
+        const LimbOps::TextSink& Sink;
+        const char* Alphabet;
+        char Buffer[4096];
+        size_t Count;
+    };
+
+    // 把一组 value 写成 radix 进制输出。width 为0时不补前导0，否则正好输出 width 位
+    void AppendChunk(TextWriter& out, Limb value, size_t width, int radix)
+    {
+        char buffer[LIMB_BITS];
+        size_t count = 0;
+        do
+        {
+            buffer[count++] = static_cast<char>(value % static_cast<Limb>(radix));
+            value /= static_cast<Limb>(radix);
+        } while (value != 0);
+
+        out.Fill('0', width > count ? width - count : 0);
+        while (count > 0)
+        {
+            out.PutDigit(static_cast<Limb>(buffer[--count]));
+        }
+    }
+
+    // 逐次除以 radix^chunkDigits（十进制为 10^19），低位组先得到，最后自高向低输出。a 会被修改
+    void ToRadixBasecase(TextWriter& out, Limb* a, size_t n, size_t width, int radix)
+    {
+        size_t chunkDigits;
+        Limb chunkBase = LargestChunkBase(radix, chunkDigits);
+        std::vector<Limb> chunks;
+        n = LimbOps::Normalized(a, n);
+        while (n > 0)
+        {
+            chunks.push_back(LimbOps::DivRem1(a, a, n, chunkBase));
+            n = LimbOps::Normalized(a, n);
+        }
+
+        if (chunks.empty())
+        {
+            out.Fill('0', width);
+            return;
+        }
+
+        size_t topWidth = 0;
+        if (width != 0)
+        {
+            topWidth = width - chunkDigits * (chunks.size() - 1);
+        }
+        AppendChunk(out, chunks.back(), topWidth, radix);
+        for (size_t i = chunks.size() - 1; i > 0; --i)
+        {
+            AppendChunk(out, chunks[i - 1], chunkDigits, radix);
+        }
+    }
+
+    // 分治：a = q * 10^(19*2^k) + r，先输出 q，再把 r 补齐到 19*2^k 位输出。
+    // 高位总是先写出，所以输出可以边算边交给 sink
+    void ToDecimalRecursive(TextWriter& out, Limb* a, size_t n, size_t width)
+    {
+        n = LimbOps::Normalized(a, n);
+        if (n <= TOSTR_DC_THRESHOLD)
+        {
+            ToRadixBasecase(out, a, n, width, 10);
+            return;
+        }
+
+        // 选取不超过 a 一半长度的最大的幂
+        size_t k = 0;
+        while (DecimalPower(k + 1).size() * 2 <= n + 1)
+        {
+            ++k;
+        }
+        const std::vector<Limb>& power = DecimalPower(k);
+        size_t pn = power.size();
+        size_t lowDigits = ChunkDigits << k;
+
+        std::vector<Limb> q(n - pn + 1), r(pn);
+        LimbOps::DivRem(q.data(), r.data(), a, n, power.data(), pn);
+
+        ToDecimalRecursive(out, q.data(), q.size(), width == 0 ? 0 : width - lowDigits);
+        ToDecimalRecursive(out, r.data(), r.size(), lowDigits);
+    }
+
+    // 2 的幂进制：从最高的数字开始，每个数字直接取 bitsPerDigit 个二进制位
+    void ToPowerOfTwoRadix(TextWriter& out, const Limb* a, size_t n, unsigned bitsPerDigit)
+    {
+        size_t bits = LimbOps::BitLength(a, n);
+        size_t count = (bits + bitsPerDigit - 1) / bitsPerDigit;
+        for (size_t i = count; i > 0; --i)
+        {
+            size_t bit = (i - 1) * bitsPerDigit;
+            out.PutDigit(LimbOps::ExtractBits(a, bit, std::min<size_t>(bitsPerDigit, n * LIMB_BITS - bit)));
+        }
+    }
+
+    // 字符对应的数值，不是合法数字时返回 -1
+    int DigitValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    Limb CheckedDigit(char c, int radix)
+    {
+        int value = DigitValue(c);
+        if (value < 0 || value >= radix)
+        {
+            throw std::invalid_argument("Invalid digit for radix");
+        }
+        return static_cast<Limb>(value);
+    }
+
+    // r[0..n) = r * scale + add，超出 n 个字的部分丢弃。used 为 r 当前的有效字数
+    void MulAddWord(Limb* r, size_t n, size_t& used, Limb scale, Limb add)
+    {
+        Limb carry = LimbOps::Mul1(r, r, used, scale);
+        for (size_t i = 0; i < used && add != 0; ++i)
+        {
+            r[i] += add;
+            add = r[i] < add ? 1 : 0;
+        }
+        carry += add;
+        if (carry != 0 && used < n)
+        {
+            r[used++] = carry;
+        }
+    }
+
+    // 一般进制：每次读入 chunkDigits 位（radix^chunkDigits 是一个字能容纳的最大幂），结果保留低 n 个字
+    void FromRadixBasecase(Limb* r, size_t n, const char* digits, size_t len, int radix)
+    {
+        size_t chunkDigits;
+        LargestChunkBase(radix, chunkDigits);
+
+        std::fill(r, r + n, 0);
+        size_t used = 0;
+        size_t first = len % chunkDigits == 0 ? chunkDigits : len % chunkDigits;
+        for (size_t pos = 0; pos < len;)
+        {
+            size_t count = pos == 0 ? std::min(first, len) : chunkDigits;
+            Limb chunk = 0;
+            Limb scale = 1;
+            for (size_t i = 0; i < count; ++i)
+            {
+                chunk = chunk * static_cast<Limb>(radix) + CheckedDigit(digits[pos + i], radix);
+                scale *= static_cast<Limb>(radix);
+            }
+            MulAddWord(r, n, used, scale, chunk);
+            pos += count;
+        }
+    }
+
+    // 十进制分治：value = high * 10^(19*2^k) + low，low 为末尾 19*2^k 位。返回去掉高位0字的完整结果
+    std::vector<Limb> FromDecimalRecursive(const char* digits, size_t len)
+    {
+        std::vector<Limb> result;
+        if (len <= FROMSTR_DC_THRESHOLD)
+        {
+            result.resize(len / ChunkDigits + 1);
+            FromRadixBasecase(result.data(), result.size(), digits, len, 10);
+        }
+        else
+        {
+            size_t k = 0;
+            while ((ChunkDigits << (k + 1)) < len)
+            {
+                ++k;
+            }
+            size_t lowDigits = ChunkDigits << k;
+            std::vector<Limb> high = FromDecimalRecursive(digits, len - lowDigits);
+            std::vector<Limb> low = FromDecimalRecursive(digits + len - lowDigits, lowDigits);
+            const std::vector<Limb>& power = DecimalPower(k);
+
+            result.assign(high.size() + power.size() + 1, 0);
+            LimbOps::Mul(result.data(), high.data(), high.size(), power.data(), power.size());
+            Limb carry = LimbOps::Add(result.data(), result.data(), low.data(), low.size());
+            for (size_t i = low.size(); carry != 0; ++i)
+            {
+                carry = ++result[i] == 0 ? 1 : 0;
+            }
+        }
+        result.resize(LimbOps::Normalized(result.data(), result.size()));
+        return result;
+    }
+
+    // 2 的幂进制：每个数字直接对应 bitsPerDigit 个二进制位，从字符串末尾开始放置
+    void FromPowerOfTwoRadix(Limb* r, size_t n, const char* digits, size_t len, unsigned bitsPerDigit, int radix)
+    {
+        std::fill(r, r + n, 0);
+        size_t totalBits = n * LIMB_BITS;
+        size_t bit = 0;
+        for (size_t i = len; i > 0; --i, bit += bitsPerDigit)
+        {
+            Limb value = CheckedDigit(digits[i - 1], radix);
+            if (bit >= totalBits)
+            {
+                continue;
+            }
+            size_t index = bit / LIMB_BITS;
+            size_t offset = bit % LIMB_BITS;
+            r[index] |= value << offset;
+            if (offset + bitsPerDigit > LIMB_BITS && index + 1 < n)
+            {
+                r[index + 1] |= value >> (LIMB_BITS - offset);
+            }
+        }
+    }
+}
+
+void LimbOps::ToDecimal(std::string& out, const Limb* a, size_t n)
+{
+    WriteDigits([&out](const char* text, size_t length) { out.append(text, length); }, a, n, 10, false);
+}
+
+void LimbOps::WriteDigits(const TextSink& sink, const Limb* a, size_t n, int radix, bool uppercase)
+{
+    CheckRadix(radix);
+    TextWriter out(sink, uppercase ? UpperDigits : LowerDigits);
+    n = Normalized(a, n);
+    unsigned bitsPerDigit = BitsPerDigit(radix);
+    if (n == 0)
+    {
+        out.Put('0');
+    }
+    else if (bitsPerDigit != 0)
+    {
+        ToPowerOfTwoRadix(out, a, n, bitsPerDigit);
+    }
+    else
+    {
+        std::vector<Limb> work(a, a + n);
+        if (radix == 10)
+        {
+            ToDecimalRecursive(out, work.data(), n, 0);
+        }
+        else
+        {
+            ToRadixBasecase(out, work.data(), n, 0, radix);
+        }
+    }
+    out.Flush();
+}
+
+size_t LimbOps::DigitCountBound(size_t BitSize, int radix)
+{
+    CheckRadix(radix);
+    if (BitSize == 0)
+    {
+        return 1;
+    }
+    unsigned bitsPerDigit = BitsPerDigit(radix);
+    if (bitsPerDigit != 0)
+    {
+        return (BitSize + bitsPerDigit - 1) / bitsPerDigit;
+    }
+
+    // BitSize 位的数不超过 ceil(BitSize * log_radix(2)) 位，多留一位抵消浮点误差
+    double digits = static_cast<double>(BitSize) * (std::log(2.0) / std::log(static_cast<double>(radix)));
+    return static_cast<size_t>(digits) + 2;
+}
+
+void LimbOps::FromString(Limb* r, size_t n, const char* digits, size_t len, int radix)
+{
+    CheckRadix(radix);
+
+    unsigned bitsPerDigit = BitsPerDigit(radix);
+    if (bitsPerDigit != 0)
+    {
+        FromPowerOfTwoRadix(r, n, digits, len, bitsPerDigit, radix);
+    }
+    else if (radix == 10 && len > FROMSTR_DC_THRESHOLD)
+    {
+        std::vector<Limb> value = FromDecimalRecursive(digits, len);
+        std::fill(r, r + n, 0);
+        std::copy(value.begin(), value.begin() + std::min(n, value.size()), r);
+    }
+    else
+    {
+        FromRadixBasecase(r, n, digits, len, radix);
+    }
+}
@@ -0,0 +1,265 @@
+#include "ThreadPool.h"
+#include "LimbOps.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // 一次 ParallelInvoke 提交的一组任务
+    struct TaskGroup
+    {
+        std::atomic<size_t> Pending{ 0 };
+        std::mutex ErrorLock;
+        std::exception_ptr Error;
+    };
+
+    struct Task
+    {
+        std::function<void()>* Fn;
+        TaskGroup* Group;
+    };
+
+    // 每个线程一个双端队列：自己从尾部取（最近提交、数据还在缓存中），空闲线程从头部窃取（最早提交、通常最大）
+    struct TaskQueue
+    {
+        std::mutex Lock;
+        std::deque<Task> Tasks;
+    };
+
+    class ThreadPool
+    {
+    public:
+        ~ThreadPool()
+        {
+            StopWorkers();
+        }
+
+        size_t GetThreadCount() const
+        {
+            return Workers.size() + 1;
+        }
+
+        // 调用线程本身也算一个线程，因此启动 count-1 个工作线程
+        void SetThreadCount(size_t count)
+        {
+            StopWorkers();
+
+            size_t workers = count > 1 ? count - 1 : 0;
+            Queues.clear();
+            for (size_t i = 0; i <= workers; ++i)
+            {
+                Queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+            }
+
+            Stop = false;
+            for (size_t i = 0; i < workers; ++i)
+            {
+                Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+            }
+        }
+
+        void Invoke(std::function<void()>* tasks, size_t count)
+        {
+            size_t self = CurrentQueue();
+            TaskGroup group;
+            group.Pending = count - 1;
+            {
+                std::lock_guard<std::mutex> lock(Queues[self]->Lock);
+                for (size_t i = 1; i < count; ++i)
+                {
+                    Queues[self]->Tasks.push_back(Task{ &tasks[i], &group });
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(WakeLock);
+                Queued += count - 1;
+            }
+            WakeUp.notify_all();
+
+            Execute(Task{ &tasks[0], &group }, false);
+            while (group.Pending.load() != 0)
+            {
+                if (!TryRunOne(self))
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (group.Error)
+            {
+                std::rethrow_exception(group.Error);
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<TaskQueue>> Queues;   // 最后一个队列给不属于线程池的线程使用
+        std::vector<std::thread> Workers;
+        std::mutex WakeLock;
+        std::condition_variable WakeUp;
+        size_t Queued = 0;
+        bool Stop = false;
+
+        static thread_local size_t WorkerIndex;
+
+        size_t CurrentQueue() const
+        {
+            return WorkerIndex < Workers.size() ? WorkerIndex : Workers.size();
+        }
+
+        void StopWorkers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(WakeLock);
+                Stop = true;
+            }
+            WakeUp.notify_all();
+            for (std::thread& worker : Workers)
+            {
+                worker.join();
+            }
+            Workers.clear();
+        }
+
+        void WorkerLoop(size_t index)
+        {
+            WorkerIndex = index;
+            for (;;)
+            {
+                if (TryRunOne(index))
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(WakeLock);
+                WakeUp.wait(lock, [this] { return Stop || Queued > 0; });
+                if (Stop)
+                {
+                    return;
+                }
+            }
+        }
+
+        bool TryRunOne(size_t self)
+        {
+            Task task;
+            if (!Pop(self, true, task))
+            {
+                bool found = false;
+                for (size_t i = 1; i < Queues.size() && !found; ++i)
+                {
+                    found = Pop((self + i) % Queues.size(), false, task);
+                }
+                if (!found)
+                {
+                    return false;
+                }
+            }
+
+            Execute(task, true);
+            return true;
+        }
+
+        bool Pop(size_t index, bool back, Task& task)
+        {
+            TaskQueue& queue = *Queues[index];
+            std::lock_guard<std::mutex> lock(queue.Lock);
+            if (queue.Tasks.empty())
+            {
+                return false;
+            }
+            if (back)
+            {
+                task = queue.Tasks.back();
+                queue.Tasks.pop_back();
+            }
+            else
+            {
+                task = queue.Tasks.front();
+                queue.Tasks.pop_front();
+            }
+
+            std::lock_guard<std::mutex> wakeLock(WakeLock);
+            --Queued;
+            return true;
+        }
+
+        static void Execute(const Task& task, bool counted)
+        {
+            try
+            {
+                (*task.Fn)();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(task.Group->ErrorLock);
+                if (!task.Group->Error)
+                {
+                    task.Group->Error = std::current_exception();
+                }
+            }
+            if (counted)
+            {
+                task.Group->Pending.fetch_sub(1);
+            }
+        }
+    };
+
+    thread_local size_t ThreadPool::WorkerIndex = static_cast<size_t>(-1);
+
+    ThreadPool& Pool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    std::atomic<size_t> ThreadCount{ 1 };
+}
+
+void LimbOps::SetThreadCount(size_t count)
+{
+    if (count == 0)
+    {
+        count = std::thread::hardware_concurrency();
+        if (count == 0)
+        {
+            count = 1;
+        }
+    }
+
+    Pool().SetThreadCount(count);
+    ThreadCount = count;
+}
+
+size_t LimbOps::GetThreadCount()
+{
+    return ThreadCount;
+}
+
+bool LimbOps::ParallelEnabled()
+{
+    return ThreadCount > 1;
+}
+
+void LimbOps::ParallelInvoke(std::function<void()>* tasks, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (count == 1 || !ParallelEnabled())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            tasks[i]();
+        }
+        return;
+    }
+
+    Pool().Invoke(tasks, count);
+}
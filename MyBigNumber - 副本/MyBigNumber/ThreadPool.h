@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// 乘法内部使用的工作窃取线程池。线程数由 LimbOps::SetThreadCount 设置
+namespace LimbOps
+{
+	// 线程数大于1时返回 true
+	bool ParallelEnabled();
+
+	// 执行 count 个互不依赖的任务，全部完成后返回。当前线程也参与执行，
+	// 等待期间会继续窃取其他任务，因此任务内部可以再次调用 ParallelInvoke。
+	// 任务抛出的异常在全部任务结束后重新抛出。未开启多线程时在当前线程依次执行
+	void ParallelInvoke(std::function<void()>* tasks, size_t count);
+}
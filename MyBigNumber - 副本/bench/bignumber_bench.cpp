@@ -0,0 +1,389 @@
+// 按位宽测量各个公开运算的耗时，输出 ns/op 与 ops/s，可以写成 JSON / CSV 并与保存的基线比较。
+//
+//   bignumber_bench [--min-bits N] [--max-bits N] [--ops parse,add,...] [--time-ms T] [--threads N]
+//                   [--json FILE] [--csv FILE] [--baseline FILE] [--threshold PCT]
+//
+// 位宽从 --min-bits 到 --max-bits 逐次翻倍（默认 8 到 1048576）。每个用例先试跑，再把重复次数
+// 加到总耗时达到 --time-ms（默认100ms），最慢的用例至少跑一次。--baseline 接受本程序写出的
+// JSON 或 CSV，比基线慢超过 --threshold 百分比（默认10）的用例标记为 REGRESSION，此时返回1；
+// 参数或文件错误返回2
+#include "BigInt.h"
+#include "BigIntParser.h"
+#include "LimbOps.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    volatile Limb Sink;
+
+    struct Result
+    {
+        std::string Op;
+        size_t Bits;
+        double NsPerOp;
+        size_t Iterations;
+    };
+
+    // 运算所用的操作数，都是非负数：
+    //   A、B      占满 BitSize - 1 位，用于 add / sub / 位运算 / 移位 / parse / parse_stream / tostring
+    //   Equal     与 A 只差最低位，比较时需要扫描全部字
+    //   HalfA/B   只有低 BitSize / 2 位，乘积不会回绕
+    //   Divisor   只有低 BitSize / 2 位，除法得到 BitSize / 2 位的商
+    struct Operands
+    {
+        BigInt A, B, Equal, HalfA, HalfB, Divisor;
+        std::string Decimal;
+    };
+
+    BigInt RandomNumber(std::mt19937_64& rng, size_t BitSize, size_t ValueBits)
+    {
+        std::vector<Limb> limbs(LimbOps::LimbCount(BitSize), 0);
+        for (size_t i = 0; i < LimbOps::LimbCount(ValueBits); ++i)
+        {
+            limbs[i] = rng();
+        }
+        limbs[LimbOps::LimbCount(ValueBits) - 1] &= LimbOps::TopMask(ValueBits);
+        // 最高有效位置1，保证操作数的规模确实是 ValueBits 位
+        limbs[(ValueBits - 1) / LIMB_BITS] |= Limb(1) << ((ValueBits - 1) % LIMB_BITS);
+        return BigInt(limbs.data(), BitSize);
+    }
+
+    Operands MakeOperands(size_t BitSize)
+    {
+        std::mt19937_64 rng(BitSize);
+        size_t full = std::max<size_t>(BitSize - 1, 1);
+        size_t half = std::max<size_t>(BitSize / 2, 1);
+
+        Operands operands = {
+            RandomNumber(rng, BitSize, full),
+            RandomNumber(rng, BitSize, full),
+            BigInt(0, BitSize),
+            RandomNumber(rng, BitSize, half),
+            RandomNumber(rng, BitSize, half),
+            RandomNumber(rng, BitSize, half),
+            std::string()
+        };
+        operands.Equal = operands.A;
+        operands.Equal.ToggleBit(0);
+        operands.Decimal = operands.A.ToString();
+        return operands;
+    }
+
+    typedef std::function<Limb(const Operands&, size_t)> Body;
+
+    const std::vector<std::pair<std::string, Body>>& Operations()
+    {
+        static const std::vector<std::pair<std::string, Body>> operations = {
+            { "parse", [](const Operands& o, size_t bits) { return BigInt(o.Decimal.c_str(), bits).GetData()[0]; } },
+            { "parse_stream", [](const Operands& o, size_t bits)
+                {
+                    // 按 4KB 分块交给增量解析器
+                    BigIntParser parser;
+                    for (size_t pos = 0; pos < o.Decimal.size(); pos += 4096)
+                    {
+                        parser.Feed(o.Decimal.data() + pos, std::min<size_t>(4096, o.Decimal.size() - pos));
+                    }
+                    return parser.Finish(bits).GetData()[0];
+                } },
+            { "tostring", [](const Operands& o, size_t) { return static_cast<Limb>(o.A.ToString().size()); } },
+            { "tochars", [](const Operands& o, size_t)
+                {
+                    // 缓冲区按 MaxStringLength 在每个线程复用，只计转换本身
+                    thread_local std::vector<char> buffer;
+                    buffer.resize(o.A.MaxStringLength());
+                    return static_cast<Limb>(o.A.ToChars(buffer.data(), buffer.data() + buffer.size()).ptr - buffer.data());
+                } },
+            { "tostring_hex", [](const Operands& o, size_t) { return static_cast<Limb>(o.A.ToString(16).size()); } },
+            { "add", [](const Operands& o, size_t) { return (o.A + o.B).GetData()[0]; } },
+            { "sub", [](const Operands& o, size_t) { return (o.A - o.B).GetData()[0]; } },
+            { "mul", [](const Operands& o, size_t) { return (o.HalfA * o.HalfB).GetData()[0]; } },
+            { "div", [](const Operands& o, size_t) { return (o.A / o.Divisor).GetData()[0]; } },
+            { "mod", [](const Operands& o, size_t) { return (o.A % o.Divisor).GetData()[0]; } },
+            { "shl", [](const Operands& o, size_t bits) { return (o.A << (bits / 3)).GetData()[0]; } },
+            { "shr", [](const Operands& o, size_t bits) { return (o.A >> (bits / 3)).GetData()[0]; } },
+            { "cmp", [](const Operands& o, size_t) { return static_cast<Limb>(o.A.Compare(o.Equal)); } },
+            { "and", [](const Operands& o, size_t) { BigInt r(o.A); r &= o.B; return r.GetData()[0]; } },
+            { "or", [](const Operands& o, size_t) { BigInt r(o.A); r |= o.B; return r.GetData()[0]; } },
+            { "xor", [](const Operands& o, size_t) { BigInt r(o.A); r ^= o.B; return r.GetData()[0]; } },
+            { "add_u64", [](const Operands& o, size_t) { return (o.A + std::uint64_t(0x9E3779B97F4A7C15)).GetData()[0]; } },
+            { "mul_u64", [](const Operands& o, size_t) { return (o.HalfA * std::uint64_t(0x9E3779B97F4A7C15)).GetData()[0]; } },
+            { "div_u64", [](const Operands& o, size_t) { return (o.A / std::uint64_t(0x9E3779B97F4A7C15)).GetData()[0]; } },
+            { "cmp_i64", [](const Operands& o, size_t) { return static_cast<Limb>(o.A.Compare(std::int64_t(-12345))); } },
+            { "popcount", [](const Operands& o, size_t) { return static_cast<Limb>(o.A.PopCount()); } },
+            { "find_next", [](const Operands& o, size_t bits) { return static_cast<Limb>(o.HalfA.FindNextSetBit(bits / 2)); } }
+        };
+        return operations;
+    }
+
+    Result Measure(const std::string& op, const Body& body, const Operands& operands, size_t bits, double seconds)
+    {
+        typedef std::chrono::steady_clock Clock;
+        size_t iterations = 1;
+        for (;;)
+        {
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                Sink = Sink ^ body(operands, bits);
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (elapsed >= seconds || iterations >= (size_t(1) << 32))
+            {
+                return { op, bits, elapsed * 1e9 / static_cast<double>(iterations), iterations };
+            }
+            // 按这一轮的速度估计达到目标时间的次数，每轮最多放大100倍
+            double estimate = elapsed > 0 ? static_cast<double>(iterations) * seconds / elapsed * 1.1 : 1e9;
+            size_t next = static_cast<size_t>(std::min(estimate, static_cast<double>(iterations) * 100));
+            iterations = std::max(iterations * 2, next);
+        }
+    }
+
+    void WriteJson(const std::string& path, const std::vector<Result>& results, double seconds)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot write " + path);
+        }
+        out << "{\n  \"benchmark\": \"bignumber_bench\",\n  \"time_ms\": " << seconds * 1000 << ",\n  \"results\": [\n";
+        char line[256];
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            std::snprintf(line, sizeof(line),
+                "    {\"op\": \"%s\", \"bits\": %zu, \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f, \"iterations\": %zu}%s\n",
+                r.Op.c_str(), r.Bits, r.NsPerOp, 1e9 / r.NsPerOp, r.Iterations, i + 1 < results.size() ? "," : "");
+            out << line;
+        }
+        out << "  ]\n}\n";
+    }
+
+    void WriteCsv(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot write " + path);
+        }
+        out << "op,bits,ns_per_op,ops_per_sec,iterations\n";
+        char line[256];
+        for (const Result& r : results)
+        {
+            std::snprintf(line, sizeof(line), "%s,%zu,%.3f,%.1f,%zu\n", r.Op.c_str(), r.Bits, r.NsPerOp, 1e9 / r.NsPerOp, r.Iterations);
+            out << line;
+        }
+    }
+
+    // 取出 JSON 行中 "key": 之后的值（去掉引号）
+    bool JsonField(const std::string& line, const char* key, std::string& value)
+    {
+        std::string pattern = std::string("\"") + key + "\":";
+        size_t pos = line.find(pattern);
+        if (pos == std::string::npos)
+        {
+            return false;
+        }
+        pos = line.find_first_not_of(" \"", pos + pattern.size());
+        size_t end = line.find_first_of(",\"}", pos);
+        value = line.substr(pos, end - pos);
+        return true;
+    }
+
+    // 读取基线，返回 (op, bits) -> ns/op。本程序写出的 JSON 每条结果占一行，所以逐行解析即可
+    std::map<std::pair<std::string, size_t>, double> LoadBaseline(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("Cannot read " + path);
+        }
+
+        std::map<std::pair<std::string, size_t>, double> baseline;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::string op, bits, ns;
+            if (line.find('{') != std::string::npos || line.find('"') != std::string::npos)
+            {
+                if (!JsonField(line, "op", op) || !JsonField(line, "bits", bits) || !JsonField(line, "ns_per_op", ns))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                std::istringstream fields(line);
+                if (!std::getline(fields, op, ',') || !std::getline(fields, bits, ',') || !std::getline(fields, ns, ',') || op == "op")
+                {
+                    continue;
+                }
+            }
+            baseline[std::make_pair(op, static_cast<size_t>(std::strtoull(bits.c_str(), nullptr, 10)))] = std::strtod(ns.c_str(), nullptr);
+        }
+        return baseline;
+    }
+
+    std::vector<std::string> Split(const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::istringstream in(list);
+        std::string item;
+        while (std::getline(in, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    void Usage()
+    {
+        std::fprintf(stderr,
+            "usage: bignumber_bench [--min-bits N] [--max-bits N] [--ops LIST] [--time-ms T] [--threads N]\n"
+            "                       [--json FILE] [--csv FILE] [--baseline FILE] [--threshold PCT]\n"
+            "ops: parse,parse_stream,tostring,tochars,tostring_hex,add,sub,mul,div,mod,shl,shr,cmp,\n"
+            "     and,or,xor,add_u64,mul_u64,div_u64,cmp_i64,popcount,find_next\n"
+            "     (default: all)\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t minBits = SIZE_8BIT, maxBits = size_t(1) << 20;
+    double seconds = 0.1, threshold = 10;
+    std::string jsonPath, csvPath, baselinePath;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            Usage();
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            Usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (arg == "--min-bits") minBits = std::strtoull(value, nullptr, 10);
+        else if (arg == "--max-bits") maxBits = std::strtoull(value, nullptr, 10);
+        else if (arg == "--ops") selected = Split(value);
+        else if (arg == "--time-ms") seconds = std::strtod(value, nullptr) / 1000;
+        else if (arg == "--threads") LimbOps::SetThreadCount(std::strtoull(value, nullptr, 10));
+        else if (arg == "--json") jsonPath = value;
+        else if (arg == "--csv") csvPath = value;
+        else if (arg == "--baseline") baselinePath = value;
+        else if (arg == "--threshold") threshold = std::strtod(value, nullptr);
+        else
+        {
+            Usage();
+            return 2;
+        }
+    }
+    if (minBits < 2 || maxBits < minBits)
+    {
+        std::fprintf(stderr, "invalid bit range\n");
+        return 2;
+    }
+
+    std::vector<std::pair<std::string, Body>> operations;
+    for (const auto& operation : Operations())
+    {
+        if (selected.empty() || std::find(selected.begin(), selected.end(), operation.first) != selected.end())
+        {
+            operations.push_back(operation);
+        }
+    }
+    for (const std::string& name : selected)
+    {
+        bool known = std::any_of(Operations().begin(), Operations().end(),
+            [&](const std::pair<std::string, Body>& operation) { return operation.first == name; });
+        if (!known)
+        {
+            std::fprintf(stderr, "unknown op: %s\n", name.c_str());
+            return 2;
+        }
+    }
+
+    try
+    {
+        std::map<std::pair<std::string, size_t>, double> baseline;
+        if (!baselinePath.empty())
+        {
+            baseline = LoadBaseline(baselinePath);
+        }
+
+        std::printf("%-12s %9s %16s %16s %12s", "op", "bits", "ns/op", "ops/s", "iterations");
+        if (!baseline.empty())
+        {
+            std::printf(" %16s %9s", "baseline ns/op", "change");
+        }
+        std::printf("\n");
+
+        std::vector<Result> results;
+        int regressions = 0;
+        for (size_t bits = minBits; bits <= maxBits; bits *= 2)
+        {
+            Operands operands = MakeOperands(bits);
+            for (const auto& operation : operations)
+            {
+                Result r = Measure(operation.first, operation.second, operands, bits, seconds);
+                results.push_back(r);
+                std::printf("%-12s %9zu %16.2f %16.1f %12zu", r.Op.c_str(), r.Bits, r.NsPerOp, 1e9 / r.NsPerOp, r.Iterations);
+
+                auto base = baseline.find(std::make_pair(r.Op, r.Bits));
+                if (base != baseline.end() && base->second > 0)
+                {
+                    double change = (r.NsPerOp - base->second) / base->second * 100;
+                    std::printf(" %16.2f %+8.1f%%", base->second, change);
+                    if (change > threshold)
+                    {
+                        std::printf("  REGRESSION");
+                        ++regressions;
+                    }
+                }
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+        }
+
+        if (!jsonPath.empty())
+        {
+            WriteJson(jsonPath, results, seconds);
+        }
+        if (!csvPath.empty())
+        {
+            WriteCsv(csvPath, results);
+        }
+        if (!baseline.empty())
+        {
+            std::printf("%d regression(s) over %.1f%%\n", regressions, threshold);
+        }
+        return regressions > 0 ? 1 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+}
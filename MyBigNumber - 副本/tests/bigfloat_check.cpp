@@ -0,0 +1,183 @@
+// BigFloat 的十进制解析在指数较大时只把 5^k 算到工作精度，这里与用 BigInt 精确算出再只舍入一次的结果对照，
+// 并检查很大的指数能很快得到结果；ToDouble 上溢时按舍入方式得到最大有限值或无穷大。全部一致时返回0
+#include "BigFloat.h"
+#include "BigInt.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    const RoundingMode Modes[] = { RoundingMode::NearestEven, RoundingMode::NearestAway, RoundingMode::TowardZero,
+        RoundingMode::Upward, RoundingMode::Downward };
+
+    int Failures = 0;
+
+    void Check(bool condition, const char* what, const std::string& detail)
+    {
+        if (!condition)
+        {
+            ++Failures;
+            std::printf("FAILED %s: %s\n", what, detail.c_str());
+        }
+    }
+
+    // 足以精确容纳 digits 位十进制数的位宽
+    size_t BitsForDigits(size_t digits)
+    {
+        return digits * 3322 / 1000 + 8;
+    }
+
+    // mantissa * 10^exponent10 精确舍入到 precision 位：先得到精确值（或带粘滞位的足够长的商），再只舍入一次
+    BigFloat Reference(const std::string& mantissa, long long exponent10, size_t precision, RoundingMode mode)
+    {
+        if (exponent10 >= 0)
+        {
+            std::string digits = mantissa + std::string(static_cast<size_t>(exponent10), '0');
+            size_t width = BitsForDigits(digits.size());
+            BigFloat exact(BigInt(digits.c_str(), width), width);
+            exact.SetRoundingMode(mode);
+            exact.SetPrecision(precision);
+            return exact;
+        }
+
+        // mantissa / 10^k = q * 2^-shift + 余数，q 至少有 precision + 2 位，余数不为0时在 q 后补一个1作为粘滞位
+        size_t k = static_cast<size_t>(-exponent10);
+        size_t shift = precision + 4 + BitsForDigits(k);
+        size_t width = shift + BitsForDigits(mantissa.size() + k) + 8;
+        BigInt dividend(mantissa.c_str(), width);
+        dividend <<= shift;
+        BigInt divisor(("1" + std::string(k, '0')).c_str(), width);
+        BigInt quotient = dividend / divisor;
+        BigInt remainder = dividend % divisor;
+        quotient <<= 1;
+        if (remainder != 0)
+        {
+            quotient += BigInt(1, width);
+        }
+        BigInt scale(1, width);
+        scale <<= shift + 1;
+        BigFloat exact = BigFloat(quotient, width) / BigFloat(scale, width);   // 除以2的幂是精确的
+        exact.SetRoundingMode(mode);
+        exact.SetPrecision(precision);
+        return exact;
+    }
+
+    void CheckAgainstExact()
+    {
+        const char* mantissas[] = { "1", "7", "123456789", "98765432109876543210" };
+        const long long exponents[] = { 30, 100, 345, 1000, 3000 };
+        const size_t precisions[] = { 24, 53, 113, 300 };
+        for (const char* mantissa : mantissas)
+        {
+            for (long long magnitude : exponents)
+            {
+                for (long long exponent10 : { magnitude, -magnitude })
+                {
+                    for (size_t precision : precisions)
+                    {
+                        for (RoundingMode mode : Modes)
+                        {
+                            std::string text = std::string(mantissa) + "e" + std::to_string(exponent10);
+                            BigFloat parsed(text.c_str(), precision, mode);
+                            BigFloat expected = Reference(mantissa, exponent10, precision, mode);
+                            std::string detail = text + " at " + std::to_string(precision) + " bits, mode " +
+                                std::to_string(static_cast<int>(mode));
+                            Check(parsed == expected && parsed.GetExponent() == expected.GetExponent(), "parse", detail);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 指数大到无法精确计算 5^k 时，只检查耗时、指数以及不同舍入方式之间的关系
+    void CheckHugeExponent(long long exponent10)
+    {
+        std::string text = "1e" + std::to_string(exponent10);
+        auto start = std::chrono::steady_clock::now();
+        BigFloat down(text.c_str(), 53, RoundingMode::Downward);
+        BigFloat up(text.c_str(), 53, RoundingMode::Upward);
+        BigFloat wide(text.c_str(), 200, RoundingMode::Downward);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Check(seconds < 5.0, "huge exponent is fast", text + " took " + std::to_string(seconds) + " s");
+
+        // 10^e 不是2的幂，向上与向下舍入正好相差一个最低位
+        Check(up > down, "Upward above Downward", text);
+        Check(up.GetExponent() == down.GetExponent() || up.GetExponent() == down.GetExponent() + 1, "adjacent", text);
+
+        // 向下舍入两次与一次相同
+        wide.SetPrecision(53);
+        Check(wide == down, "wider Downward rounds to the same value", text);
+
+        // M 有 53 位，最高位为 2^52，所以指数是 floor(e * log2(10)) - 52
+        long double top = std::floor(static_cast<long double>(exponent10) * 3.32192809488736234787L);
+        long long expected = static_cast<long long>(top) - 52;
+        Check(down.GetExponent() == expected, "exponent", text + " gives " + std::to_string(down.GetExponent()));
+    }
+
+    // 舍入后不小于 2^1024 的值：舍入方向朝向0时得到最大有限值，否则得到无穷大
+    void CheckOverflow()
+    {
+        const double infinity = std::numeric_limits<double>::infinity();
+        const double largest = std::numeric_limits<double>::max();
+        BigInt power(1, 1100);
+        power <<= 1024;
+        BigFloat positive(power, 53);
+        BigFloat negative = -positive;
+        for (RoundingMode mode : Modes)
+        {
+            std::string detail = "mode " + std::to_string(static_cast<int>(mode));
+            positive.SetRoundingMode(mode);
+            negative.SetRoundingMode(mode);
+            bool positiveFinite = mode == RoundingMode::TowardZero || mode == RoundingMode::Downward;
+            bool negativeFinite = mode == RoundingMode::TowardZero || mode == RoundingMode::Upward;
+            Check(positive.ToDouble() == (positiveFinite ? largest : infinity), "2^1024 to double", detail);
+            Check(negative.ToDouble() == (negativeFinite ? -largest : -infinity), "-2^1024 to double", detail);
+        }
+
+        // DBL_MAX 与 2^1024 正中间：就近舍入进位到 2^1024 而上溢，向0舍入回到 DBL_MAX
+        BigFloat half(largest, 60);
+        half += BigFloat(std::ldexp(1.0, 970), 60);
+        half.SetRoundingMode(RoundingMode::NearestEven);
+        Check(half.ToDouble() == infinity, "halfway above DBL_MAX, NearestEven", "");
+        half.SetRoundingMode(RoundingMode::TowardZero);
+        Check(half.ToDouble() == largest, "halfway above DBL_MAX, TowardZero", "");
+        Check(BigFloat(largest, 53).ToDouble() == largest, "DBL_MAX round trips", "");
+    }
+}
+
+int main()
+{
+    CheckOverflow();
+
+    CheckAgainstExact();
+
+    CheckHugeExponent(10000000);
+    CheckHugeExponent(1000000000);
+    CheckHugeExponent(-1000000000);
+    CheckHugeExponent(1000000000000LL);
+    CheckHugeExponent(-1000000000000LL);
+
+    BigFloat largest("1e1000000000000000", 53);
+    Check(largest.GetExponent() > 0, "exponent 10^15 is accepted", "");
+    bool threw = false;
+    try
+    {
+        BigFloat value("1e1000000000000001", 53);
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    Check(threw, "exponent past 10^15 throws", "");
+
+    if (Failures == 0)
+    {
+        std::printf("bigfloat_check: all passed\n");
+    }
+    return Failures == 0 ? 0 : 1;
+}
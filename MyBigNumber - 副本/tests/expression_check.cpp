@@ -0,0 +1,175 @@
+// 把 Expression.h 中惰性表达式的结果与逐个调用 BigInt 运算符的结果对照，重点是目标同时出现在表达式里
+// 的原地求值（LeftChainInPlace / CountReferences）和字数在 FusedBasecaseLimbs 两侧的乘加融合。全部一致时返回0
+#include "BigInt.h"
+#include "Expression.h"
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Expr::Lazy;
+
+    int Failures = 0;
+
+    void Check(const BigInt& actual, const BigInt& expected, const char* what, size_t bits)
+    {
+        if (actual != expected)
+        {
+            ++Failures;
+            std::printf("FAILED %s at %zu bits\n", what, bits);
+        }
+    }
+
+    BigInt RandomValue(std::mt19937_64& rng, size_t bits)
+    {
+        std::vector<Limb> limbs(LimbOps::LimbCount(bits));
+        for (Limb& limb : limbs)
+        {
+            limb = rng();
+        }
+        return BigInt(limbs.data(), bits);
+    }
+
+    BigInt ShiftedLeft(BigInt value, size_t shift)
+    {
+        value <<= shift;
+        return value;
+    }
+
+    BigInt ShiftedRight(BigInt value, size_t shift)
+    {
+        value >>= shift;
+        return value;
+    }
+
+    void CheckShapes(std::mt19937_64& rng, size_t bits)
+    {
+        BigInt a = RandomValue(rng, bits);
+        BigInt b = RandomValue(rng, bits);
+        BigInt c = RandomValue(rng, bits);
+        BigInt d = RandomValue(rng, bits);
+        size_t shift = rng() % (bits + 8);
+
+        // 头文件注释中列出的用法
+        {
+            BigInt acc = d;
+            acc += Lazy(a) * b;
+            Check(acc, d + a * b, "acc += Lazy(a) * b", bits);
+        }
+        {
+            BigInt acc = d;
+            acc -= Lazy(a) * b;
+            BigInt expected = d;
+            expected -= a * b;
+            Check(acc, expected, "acc -= Lazy(a) * b", bits);
+        }
+        {
+            BigInt r = d;
+            r = Lazy(a) + (Lazy(b) << 7);
+            Check(r, a + ShiftedLeft(b, 7), "r = Lazy(a) + (Lazy(b) << 7)", bits);
+        }
+        {
+            BigInt r = d;
+            r = Lazy(a) + (Lazy(b) << shift);
+            Check(r, a + ShiftedLeft(b, shift), "r = Lazy(a) + (Lazy(b) << k)", bits);
+        }
+        {
+            BigInt r = d;
+            r = Lazy(a) + Lazy(b) * c - d;
+            Check(r, a + b * c - d, "r = Lazy(a) + Lazy(b) * c - d", bits);
+        }
+        {
+            BigInt r(Lazy(a) + b * Lazy(c) - d);
+            Check(r, a + b * c - d, "BigInt(expression)", bits);
+        }
+        {
+            BigInt r = d;
+            r = (Lazy(a) >> shift) - b;
+            Check(r, ShiftedRight(a, shift) - b, "r = (Lazy(a) >> k) - b", bits);
+        }
+
+        // 目标出现在表达式中：最左边且只出现一次时原地求值，否则先算到新对象
+        {
+            BigInt x = a;
+            x = Lazy(x) + Lazy(x) * b;
+            Check(x, a + a * b, "x = Lazy(x) + Lazy(x) * y", bits);
+        }
+        {
+            BigInt x = a;
+            x = Lazy(b) * x + x;
+            Check(x, b * a + a, "x = Lazy(y) * x + x", bits);
+        }
+        {
+            BigInt x = a;
+            x = x + Lazy(b) * c;
+            Check(x, a + b * c, "x = x + Lazy(y) * z", bits);
+        }
+        {
+            BigInt x = a;
+            x = Lazy(x) - (Lazy(x) << shift);
+            Check(x, a - ShiftedLeft(a, shift), "x = Lazy(x) - (Lazy(x) << k)", bits);
+        }
+        {
+            BigInt x = a;
+            x += Lazy(x) * x;
+            Check(x, a + a * a, "x += Lazy(x) * x", bits);
+        }
+        {
+            BigInt x = a;
+            x -= (Lazy(b) + x) * (Lazy(c) - x);
+            BigInt expected = a;
+            expected -= (b + a) * (c - a);
+            Check(x, expected, "x -= (Lazy(y) + x) * (Lazy(z) - x)", bits);
+        }
+
+        // 与机器整数相乘
+        {
+            std::int64_t factor = static_cast<std::int64_t>(rng());
+            BigInt x = a;
+            x = Lazy(x) * factor;
+            Check(x, a * BigInt(factor, bits), "x = Lazy(x) * int64", bits);
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng(14);
+    // 字数在 FusedBasecaseLimbs（32字）两侧，以及不满一个字、很大的位宽
+    const size_t limbs = Expr::FusedBasecaseLimbs;
+    const size_t sizes[] = { 8, 63, 64, 65, 130, 500, LIMB_BITS * (limbs - 1) + 5, LIMB_BITS * limbs,
+        LIMB_BITS * limbs + 1, LIMB_BITS * (limbs + 1), 5000, 70000 };
+    for (size_t bits : sizes)
+    {
+        for (int round = 0; round < 20; ++round)
+        {
+            CheckShapes(rng, bits);
+        }
+    }
+
+    bool threw = false;
+    try
+    {
+        BigInt narrow = RandomValue(rng, 64);
+        BigInt wide = RandomValue(rng, 128);
+        BigInt result(Lazy(narrow) + wide);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    if (!threw)
+    {
+        ++Failures;
+        std::printf("FAILED mismatched bit sizes do not throw\n");
+    }
+
+    if (Failures == 0)
+    {
+        std::printf("expression_check: all passed\n");
+    }
+    return Failures == 0 ? 0 : 1;
+}
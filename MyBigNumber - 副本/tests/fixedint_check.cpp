@@ -0,0 +1,141 @@
+// FixedInt 是只有头文件的模板，库本身不会实例化它。这里用 static_assert 检查 constexpr 运算，
+// 再把运行时的除法、取余和各种转换与同位宽的 BigInt 对照。全部一致时返回0
+#include "BigInt.h"
+#include "FixedInt.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef FixedInt<128> Int128;
+    typedef FixedInt<256> Int256;
+    typedef FixedInt<100> Int100;
+
+    // 编译期运算
+    static_assert((Int128(40) + Int128(2)) == Int128(42), "constexpr +");
+    static_assert((Int128(0) - Int128(1)) == Int128(-1), "constexpr - wraps to -1");
+    static_assert((Int128(-1)).GetData()[1] == ~Limb(0), "sign extension");
+    static_assert(Int128(std::uint64_t(1) << 63).GetData()[1] == 0, "unsigned zero extension");
+    static_assert(Int128(5u) == Int128(5), "unsigned int");
+    static_assert((Int128(std::uint64_t(1) << 63) * Int128(4)).GetData()[1] == 2, "constexpr * carries across limbs");
+    static_assert((Int128(-3) * Int128(7)) == Int128(-21), "constexpr signed *");
+    static_assert((Int128(1) << 127).IsNegative(), "constexpr <<");
+    static_assert((Int128(1) << 128) == Int128(0), "<< past the width");
+    static_assert(~Int128(0) == Int128(-1), "constexpr ~");
+    static_assert((Int256(1) << 200).GetData()[3] == (Limb(1) << 8), "constexpr << on 256 bits");
+    static_assert((Int256(-1) + Int256(1)) == Int256(0), "constexpr + on 256 bits");
+    static_assert(((Int100(1) << 99) + (Int100(1) << 99)) == Int100(0), "wrap at 100 bits");
+    static_assert(~Int100(0) == Int100(-1), "~ keeps the unused bits clear");
+    static_assert(Int100(-1).GetData()[1] == (Limb(1) << 36) - 1, "top limb masked");
+
+    int Failures = 0;
+
+    void Check(bool condition, const char* what, const std::string& detail)
+    {
+        if (!condition)
+        {
+            ++Failures;
+            std::printf("FAILED %s: %s\n", what, detail.c_str());
+        }
+    }
+
+    // 随机的补码位模式，偶尔带较多的高位0或1，覆盖正负与长短不同的操作数
+    BigInt RandomValue(std::mt19937_64& rng, size_t bits)
+    {
+        std::vector<Limb> limbs(LimbOps::LimbCount(bits));
+        for (Limb& limb : limbs)
+        {
+            limb = rng();
+        }
+        switch (rng() % 4)
+        {
+        case 0:
+            for (size_t i = 1; i < limbs.size(); ++i)
+            {
+                limbs[i] = 0;
+            }
+            break;
+        case 1:
+            for (size_t i = 1; i < limbs.size(); ++i)
+            {
+                limbs[i] = ~Limb(0);
+            }
+            break;
+        default:
+            break;
+        }
+        return BigInt(limbs.data(), bits);
+    }
+
+    template <size_t Bits>
+    void CheckAgainstBigInt(std::mt19937_64& rng, size_t rounds)
+    {
+        typedef FixedInt<Bits> Fixed;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            BigInt a = RandomValue(rng, Bits);
+            BigInt b = RandomValue(rng, Bits);
+            Fixed fa(a);
+            Fixed fb(b);
+            std::string operands = a.ToString() + ", " + b.ToString();
+
+            Check(fa.ToBigInt() == a, "FixedInt(BigInt) / ToBigInt", operands);
+            Check(fa.ToString() == a.ToString(), "ToString", operands);
+            Check(Fixed(a.ToString().c_str()) == fa, "FixedInt(const char*)", operands);
+            Check((fa + fb).ToBigInt() == a + b, "+", operands);
+            Check((fa - fb).ToBigInt() == a - b, "-", operands);
+            Check((fa * fb).ToBigInt() == a * b, "*", operands);
+            Check((fa >> 37).ToBigInt() == (a >> 37), ">>", operands);
+            Check((fa < fb) == (a < b), "<", operands);
+            if (b != 0)
+            {
+                Check((fa / fb).ToBigInt() == a / b, "/", operands);
+                Check((fa % fb).ToBigInt() == a % b, "%", operands);
+            }
+        }
+
+        bool threw = false;
+        try
+        {
+            Fixed(1) / Fixed(0);
+        }
+        catch (const std::domain_error&)
+        {
+            threw = true;
+        }
+        Check(threw, "division by zero throws", std::to_string(Bits));
+
+        threw = false;
+        try
+        {
+            Fixed value(BigInt(1, Bits + 1));
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        Check(threw, "FixedInt(BigInt) rejects a different width", std::to_string(Bits));
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng(20240601);
+    CheckAgainstBigInt<64>(rng, 2000);
+    CheckAgainstBigInt<100>(rng, 2000);
+    CheckAgainstBigInt<128>(rng, 2000);
+    CheckAgainstBigInt<256>(rng, 2000);
+    CheckAgainstBigInt<1024>(rng, 500);
+
+    Check(Int128(std::uint64_t(1) << 63).ToString() == "9223372036854775808", "unsigned 2^63", "");
+    Check(Int128(static_cast<std::int8_t>(-3)).ToString() == "-3", "int8_t", "");
+
+    if (Failures == 0)
+    {
+        std::printf("fixedint_check: all passed\n");
+    }
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// 把三素数 NTT 乘法（LimbOps::MulNtt，以及超过 MUL_NTT_THRESHOLD 后的 LimbOps::Mul 和 LimbOps::Sqr）与逐字相乘的结果对照。
+// 覆盖等长、长度相差很大和全1的操作数（全1时卷积系数最大，最接近三个素数之积的界），
+// 分别用单线程和4个线程计算。CMake 还会以很低的 MUL_NTT_THRESHOLD 再编译一份，
+// 让 Toom / 不等长乘法递归到 NTT 的路径也被覆盖。全部一致时返回0
+#include "LimbOps.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    int Failures = 0;
+
+    // 教科书式的逐字乘法，不经过任何分治
+    std::vector<Limb> Schoolbook(const std::vector<Limb>& a, const std::vector<Limb>& b)
+    {
+        std::vector<Limb> r(a.size() + b.size(), 0);
+        for (size_t j = 0; j < b.size(); ++j)
+        {
+            r[a.size() + j] = LimbOps::AddMul1(r.data() + j, a.data(), a.size(), b[j]);
+        }
+        return r;
+    }
+
+    enum class Fill
+    {
+        Random,
+        AllOnes,
+        Sparse    // 大部分字为0，只有少数随机字
+    };
+
+    std::vector<Limb> Operand(std::mt19937_64& rng, size_t n, Fill fill)
+    {
+        std::vector<Limb> a(n, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            switch (fill)
+            {
+            case Fill::Random:
+                a[i] = rng();
+                break;
+            case Fill::AllOnes:
+                a[i] = ~Limb(0);
+                break;
+            case Fill::Sparse:
+                a[i] = rng() % 16 == 0 ? rng() : 0;
+                break;
+            }
+        }
+        a[n - 1] |= Limb(1) << 63;
+        return a;
+    }
+
+    void Compare(const char* what, const std::vector<Limb>& expected, const std::vector<Limb>& actual, size_t an, size_t bn)
+    {
+        if (expected != actual)
+        {
+            ++Failures;
+            size_t first = 0;
+            while (expected[first] == actual[first])
+            {
+                ++first;
+            }
+            std::printf("FAILED %s %zu x %zu limbs, first difference at limb %zu\n", what, an, bn, first);
+        }
+    }
+
+    void CheckProduct(std::mt19937_64& rng, size_t an, size_t bn, Fill fill)
+    {
+        std::vector<Limb> a = Operand(rng, an, fill);
+        std::vector<Limb> b = Operand(rng, bn, fill);
+        std::vector<Limb> expected = Schoolbook(a, b);
+
+        std::vector<Limb> r(an + bn);
+        LimbOps::MulNtt(r.data(), a.data(), an, b.data(), bn);
+        Compare("MulNtt", expected, r, an, bn);
+
+        std::fill(r.begin(), r.end(), 0);
+        LimbOps::Mul(r.data(), a.data(), an, b.data(), bn);
+        Compare("Mul", expected, r, an, bn);
+
+        // 平方走单独的 basecase / Karatsuba，规模更大时同样进入 Toom 与 NTT
+        if (an == bn)
+        {
+            std::vector<Limb> square(2 * an);
+            LimbOps::Sqr(square.data(), a.data(), an);
+            Compare("Sqr", Schoolbook(a, a), square, an, an);
+        }
+    }
+
+    void CheckSizes(std::mt19937_64& rng)
+    {
+        // 小规模：NTT 变换长度的各个边界附近
+        const size_t small[][2] = { { 1, 1 }, { 2, 1 }, { 7, 5 }, { 47, 47 }, { 64, 64 }, { 65, 63 }, { 300, 17 }, { 1000, 999 }, { 4096, 4096 } };
+        for (const size_t* sizes : small)
+        {
+            CheckProduct(rng, sizes[0], sizes[1], Fill::Random);
+            CheckProduct(rng, sizes[0], sizes[1], Fill::AllOnes);
+        }
+
+        // 达到默认的 MUL_NTT_THRESHOLD（12000字）：等长、不等长、全1、稀疏
+        CheckProduct(rng, 12000, 12000, Fill::Random);
+        CheckProduct(rng, 12000, 12000, Fill::AllOnes);
+        CheckProduct(rng, 16384, 12001, Fill::Sparse);
+        CheckProduct(rng, 40000, 12000, Fill::Random);
+        CheckProduct(rng, 40000, 1500, Fill::AllOnes);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng(4);
+    for (size_t threads : { 1, 4 })
+    {
+        LimbOps::SetThreadCount(threads);
+        CheckSizes(rng);
+    }
+    LimbOps::SetThreadCount(1);
+
+    if (Failures == 0)
+    {
+        std::printf("ntt_check: all passed\n");
+    }
+    return Failures == 0 ? 0 : 1;
+}